@@ -0,0 +1,450 @@
+// Matching-path micro-benchmarks, run against every level-store backend and
+// against the int64-price ladder (WideLadderBook) to show the cost of 64-bit
+// prices. All inputs come from fixed seeds so runs are comparable across commits.
+
+#include <benchmark/benchmark.h>
+#include "EventLog.h"
+#include "FeedSink.h"
+#include "FlowGenerator.h"
+#include "LimitOrderBook.h"
+#include "SoaLevel.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using MapBook = LimitOrderBook<MapLevels>;
+using LadderBook = LimitOrderBook<PriceLadder>;
+using WideLadderBook = LimitOrderBook<PriceLadder, NullSink, WidePrices>; // int64 prices and quantities
+
+constexpr int MID = 10'000;
+constexpr int BATCH = 1024;
+
+// Passive orders that never cross: bids below MID, asks above
+template <typename BookOrder = Order>
+std::vector<BookOrder> passive_orders(int count, int depth, std::uint64_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> offset(1, depth);
+    std::uniform_int_distribution<int> qty(1, 100);
+    std::vector<BookOrder> orders;
+    orders.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        bool buy = i & 1;
+        int price = buy ? MID - offset(rng) : MID + offset(rng);
+        orders.push_back({static_cast<OrderId>(i + 1), buy ? Side::BUY : Side::SELL, qty(rng), price});
+    }
+    return orders;
+}
+
+// Inserts that never cross, over 100 levels per side
+template <typename Book>
+void BM_InsertNonCrossing(benchmark::State& state) {
+    auto orders = passive_orders<typename Book::Order>(BATCH, 100, 42);
+    Book book;
+
+    for (auto _ : state) {
+        for (const auto& order : orders) book.add_order(order);
+
+        state.PauseTiming();
+        for (const auto& order : orders) book.cancel_order(order.id);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH);
+}
+
+// One aggressive order sweeping K ask levels (2 orders per level)
+template <typename Book>
+void BM_SweepLevels(benchmark::State& state) {
+    const int levels = static_cast<int>(state.range(0));
+    Book book;
+    OrderId next_id = 1;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        for (int l = 0; l < levels; ++l) {
+            book.add_order({next_id++, Side::SELL, 10, MID + l});
+            book.add_order({next_id++, Side::SELL, 10, MID + l});
+        }
+        state.ResumeTiming();
+
+        book.add_order({next_id++, Side::BUY, 20 * levels, MID + levels});
+    }
+    state.SetItemsProcessed(state.iterations() * levels);
+    state.SetLabel("items = levels swept");
+}
+
+// Synthetic flow where cancels outnumber adds
+template <typename Book>
+void BM_CancelHeavyFlow(benchmark::State& state) {
+    constexpr int MESSAGES = 1 << 16;
+    FlowConfig config;
+    config.add_ratio = 0.45;
+    config.cancel_ratio = 0.50;
+    config.modify_ratio = 0.04;
+    FlowGenerator generator(config);
+
+    std::vector<OrderCommand> flow(MESSAGES);
+    for (auto& command : flow) command = generator.next();
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Book book;
+        state.ResumeTiming();
+
+        for (const OrderCommand& command : flow) apply(book, command);
+        benchmark::DoNotOptimize(book.order_count());
+    }
+    state.SetItemsProcessed(state.iterations() * MESSAGES);
+}
+
+// Add + cancel one passive order inside a book pre-filled to the given
+// number of levels per side: shows how level lookup scales with depth
+template <typename Book>
+void BM_AddCancelAtDepth(benchmark::State& state) {
+    const int depth = static_cast<int>(state.range(0));
+    Book book(BookConfig{static_cast<std::size_t>(depth) * 2, static_cast<std::size_t>(depth) * 4 + BATCH});
+
+    OrderId next_id = 1;
+    for (int l = 1; l <= depth; ++l) {
+        book.add_order({next_id++, Side::BUY, 10, MID - l});
+        book.add_order({next_id++, Side::SELL, 10, MID + l});
+    }
+    auto orders = passive_orders<typename Book::Order>(BATCH, depth, 7);
+    for (auto& order : orders) order.id += next_id;
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const auto& order = orders[i++ % BATCH];
+        book.add_order(order);
+        book.cancel_order(order.id);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+// A burst of adds from the synthetic flow: mostly passive near the mid, with
+// its usual share of marketable orders
+template <typename BookOrder = Order>
+std::vector<BookOrder> add_burst(std::size_t count) {
+    FlowGenerator generator;
+    std::vector<BookOrder> orders;
+    orders.reserve(count);
+    while (orders.size() < count) {
+        OrderCommand command = generator.next();
+        if (command.type != CommandType::ADD) continue;
+        orders.push_back({command.id, command.side, command.quantity, command.price});
+    }
+    return orders;
+}
+
+constexpr std::size_t BURST = 4096;
+
+// The burst through add_order() one call at a time: baseline for the batch API
+template <typename Book>
+void BM_AddOrderSingle(benchmark::State& state) {
+    auto orders = add_burst<typename Book::Order>(BURST);
+    for (auto _ : state) {
+        state.PauseTiming();
+        Book book;
+        state.ResumeTiming();
+
+        for (const auto& order : orders) book.add_order(order);
+        benchmark::DoNotOptimize(book.order_count());
+    }
+    state.SetItemsProcessed(state.iterations() * BURST);
+}
+
+// The same burst through add_orders() in batches of B
+template <typename Book>
+void BM_AddOrdersBatch(benchmark::State& state) {
+    const auto batch = static_cast<std::size_t>(state.range(0));
+    auto orders = add_burst<typename Book::Order>(BURST);
+    std::span<const typename Book::Order> all(orders);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        Book book;
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < BURST; i += batch) book.add_orders(all.subspan(i, std::min(batch, BURST - i)));
+        benchmark::DoNotOptimize(book.order_count());
+    }
+    state.SetItemsProcessed(state.iterations() * BURST);
+}
+
+// One trade triggering N pending stop-limits spread over 16 trigger prices.
+// Each enters as a passive bid, so the cost is extraction and re-entry only.
+template <typename Book>
+void BM_TriggerStops(benchmark::State& state) {
+    const auto stops = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto book = std::make_unique<Book>();
+        book->add_order({1, Side::SELL, 1, MID});
+        for (int i = 0; i < stops; ++i) {
+            book->add_order({static_cast<OrderId>(i + 10), Side::BUY, 1, MID - 100,
+                             OrderType::STOP_LIMIT, 0, MID - i % 16});
+        }
+        state.ResumeTiming();
+
+        book->add_order({2, Side::BUY, 1, MID});
+
+        state.PauseTiming();
+        benchmark::DoNotOptimize(book->order_count());
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * stops);
+    state.SetLabel("items = stops triggered");
+}
+
+constexpr int SWEPT_ORDERS = 1 << 16;
+
+// SWEPT_ORDERS resting orders split into levels of N, each then taken out by
+// one fill of its whole quantity, as a deep sweep would. Orders arrive
+// round-robin across the levels, so in the node layout a level's orders are
+// strided through the pool like a live book's rather than adjacent.
+template <typename Level, typename Add, typename Sweep>
+void sweep_levels(benchmark::State& state, Add add, Sweep sweep) {
+    const auto depth = static_cast<std::size_t>(state.range(0));
+    const std::size_t count = SWEPT_ORDERS / depth;
+    std::uint64_t filled = 0;
+    auto on_fill = [&filled](OrderId id, int traded, int) { filled += id + static_cast<std::uint64_t>(traded); };
+
+    std::vector<Level> levels;
+    levels.reserve(count);
+    for (auto _ : state) {
+        state.PauseTiming();
+        levels.clear(); // Last pass's teardown stays out of the timing
+        for (std::size_t l = 0; l < count; ++l) levels.emplace_back(MID + static_cast<int>(l));
+        for (std::size_t i = 0; i < SWEPT_ORDERS; ++i) add(levels[i % count], static_cast<OrderId>(i + 1), 1 + static_cast<int>(i % 7));
+        state.ResumeTiming();
+
+        for (Level& level : levels) sweep(level, on_fill);
+    }
+    benchmark::DoNotOptimize(filled);
+    state.SetItemsProcessed(state.iterations() * SWEPT_ORDERS);
+    state.SetLabel("items = orders filled");
+}
+
+// Intrusive node list (BasicPriceLevel), walked as the matcher does
+void BM_SweepNodeLevel(benchmark::State& state) {
+    ObjectPool<OrderNode> nodes(SWEPT_ORDERS);
+    sweep_levels<PriceLevel>(state,
+        [&nodes](PriceLevel& level, OrderId id, int quantity) {
+            level.push_back(nodes.create(id, Side::SELL, level.price(), quantity));
+        },
+        [&nodes](PriceLevel& level, auto& on_fill) {
+            int quantity = level.total_quantity();
+            while (quantity > 0 && !level.empty()) {
+                OrderNode* resting = level.front();
+                int traded = std::min(resting->quantity, quantity);
+                quantity -= traded;
+                level.reduce(resting, traded);
+                on_fill(resting->id, traded, resting->quantity);
+                if (resting->quantity == 0) {
+                    level.remove(resting);
+                    nodes.destroy(resting);
+                }
+            }
+        });
+}
+
+// Struct-of-arrays queue (SoaLevel), located with the SIMD prefix sum
+void BM_SweepSoaLevel(benchmark::State& state) {
+    sweep_levels<SoaLevel>(state,
+        [](SoaLevel& level, OrderId id, int quantity) { level.push_back(id, quantity); },
+        [](SoaLevel& level, auto& on_fill) { level.fill(level.total_quantity(), on_fill); });
+}
+
+constexpr int REPLAY = 1'000'000;
+
+// Synthetic order flow, and the L3 feed a venue matching it would publish
+const std::vector<OrderCommand>& replay_flow() {
+    static const std::vector<OrderCommand> flow = [] {
+        FlowGenerator generator;
+        std::vector<OrderCommand> commands(REPLAY);
+        for (OrderCommand& command : commands) command = generator.next();
+        return commands;
+    }();
+    return flow;
+}
+
+const std::vector<OrderCommand>& replay_feed() {
+    static const std::vector<OrderCommand> feed = [] {
+        std::vector<OrderCommand> commands;
+        auto matcher = std::make_unique<LimitOrderBook<PriceLadder, FeedSink>>(BookConfig{}, FeedSink(commands));
+        for (const OrderCommand& command : replay_flow()) apply(*matcher, command);
+        return commands;
+    }();
+    return feed;
+}
+
+// Matching mode: the raw flow through add_order() and friends
+template <typename Book>
+void BM_ReplayMatching(benchmark::State& state) {
+    const auto& flow = replay_flow();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto book = std::make_unique<Book>();
+        state.ResumeTiming();
+
+        for (const OrderCommand& command : flow) apply(*book, command);
+
+        state.PauseTiming();
+        benchmark::DoNotOptimize(book->order_count());
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(flow.size()));
+}
+
+// Builder mode: the same book rebuilt from its L3 feed, no matching
+template <typename Book>
+void BM_ReplayFeed(benchmark::State& state) {
+    const auto& feed = replay_feed();
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto book = std::make_unique<Book>();
+        state.ResumeTiming();
+
+        for (const OrderCommand& command : feed) apply_feed(*book, command);
+
+        state.PauseTiming();
+        benchmark::DoNotOptimize(book->order_count());
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(feed.size()));
+}
+
+std::string log_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Matching-thread cost of logging one execution report through an EventLog
+// channel while its thread formats them to a file. range(0) = 0 is a BLOCK
+// channel (the LogSink audit trail), which waits for the log thread when
+// the ring is full, so the cost includes keeping up with formatting; 1 is a
+// DROP channel, counted only for the reports that reached the file. Timed
+// on the wall clock, since a blocked producer spends its wait yielding.
+void BM_EventLogReport(benchmark::State& state) {
+    const LogOverflow overflow = state.range(0) ? LogOverflow::DROP : LogOverflow::BLOCK;
+    std::string path = log_path("lob_bench_event_log.txt");
+    std::size_t dropped = 0;
+    std::size_t stalls = 0;
+    {
+        EventLog log(path);
+        LogChannel& channel = log.channel(overflow);
+        ExecutionReport report{1, 2, MID, 10, 0, ExecType::FILL, Side::BUY, {}};
+        for (auto _ : state) {
+            channel.report(report);
+            ++report.order_id;
+        }
+        dropped = channel.dropped();
+        stalls = channel.stalls();
+    }
+    state.SetItemsProcessed(state.iterations() - static_cast<std::int64_t>(dropped));
+    state.SetLabel(overflow == LogOverflow::BLOCK ? "block" : "drop");
+    state.counters["dropped"] = static_cast<double>(dropped);
+    state.counters["stalls"] = static_cast<double>(stalls);
+    std::filesystem::remove(path);
+}
+
+// The same report formatted and flushed synchronously, as std::endl does
+void BM_StreamReport(benchmark::State& state) {
+    std::string path = log_path("lob_bench_stream_log.txt");
+    {
+        std::ofstream out(path);
+        ExecutionReport report{1, 2, MID, 10, 0, ExecType::FILL, Side::BUY, {}};
+        for (auto _ : state) {
+            out << report << std::endl;
+            ++report.order_id;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    std::filesystem::remove(path);
+}
+
+// Strategy-side load of the published top of book. With range(0) = 1 a
+// matcher thread drives synthetic flow into the same book throughout, so
+// reads contend with constant republishing; 0 is the uncontended baseline.
+void BM_TopOfBookRead(benchmark::State& state) {
+    const bool matching = state.range(0) != 0;
+    LadderBook book;
+    std::atomic<bool> stop{false};
+    std::atomic<std::uint64_t> messages{0};
+
+    std::thread matcher;
+    if (matching) {
+        matcher = std::thread([&] {
+            FlowGenerator generator;
+            std::uint64_t count = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                apply(book, generator.next());
+                ++count;
+            }
+            messages.store(count);
+        });
+    }
+
+    for (auto _ : state) {
+        TopOfBook top = book.top_of_book().load();
+        benchmark::DoNotOptimize(top);
+    }
+
+    stop.store(true);
+    if (matcher.joinable()) matcher.join();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["matcher_msgs"] = static_cast<double>(messages.load());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_InsertNonCrossing, MapBook);
+BENCHMARK_TEMPLATE(BM_InsertNonCrossing, LadderBook);
+BENCHMARK_TEMPLATE(BM_InsertNonCrossing, WideLadderBook);
+
+BENCHMARK_TEMPLATE(BM_SweepLevels, MapBook)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK_TEMPLATE(BM_SweepLevels, LadderBook)->RangeMultiplier(4)->Range(1, 256);
+BENCHMARK_TEMPLATE(BM_SweepLevels, WideLadderBook)->RangeMultiplier(4)->Range(1, 256);
+
+BENCHMARK_TEMPLATE(BM_CancelHeavyFlow, MapBook);
+BENCHMARK_TEMPLATE(BM_CancelHeavyFlow, LadderBook);
+BENCHMARK_TEMPLATE(BM_CancelHeavyFlow, WideLadderBook);
+
+// Shallow (10 levels) through deep (10k levels)
+BENCHMARK_TEMPLATE(BM_AddCancelAtDepth, MapBook)->RangeMultiplier(10)->Range(10, 10'000);
+BENCHMARK_TEMPLATE(BM_AddCancelAtDepth, LadderBook)->RangeMultiplier(10)->Range(10, 10'000);
+BENCHMARK_TEMPLATE(BM_AddCancelAtDepth, WideLadderBook)->RangeMultiplier(10)->Range(10, 10'000);
+
+BENCHMARK_TEMPLATE(BM_AddOrderSingle, MapBook);
+BENCHMARK_TEMPLATE(BM_AddOrderSingle, LadderBook);
+
+BENCHMARK_TEMPLATE(BM_AddOrdersBatch, MapBook)->RangeMultiplier(4)->Range(1, 1024);
+BENCHMARK_TEMPLATE(BM_AddOrdersBatch, LadderBook)->RangeMultiplier(4)->Range(1, 1024);
+
+BENCHMARK_TEMPLATE(BM_TriggerStops, MapBook)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK_TEMPLATE(BM_TriggerStops, LadderBook)->RangeMultiplier(8)->Range(8, 4096);
+
+BENCHMARK_TEMPLATE(BM_ReplayMatching, MapBook)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReplayMatching, LadderBook)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReplayFeed, MapBook)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_ReplayFeed, LadderBook)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_SweepNodeLevel)->RangeMultiplier(8)->Range(8, 4096);
+BENCHMARK(BM_SweepSoaLevel)->RangeMultiplier(8)->Range(8, 4096);
+
+BENCHMARK(BM_EventLogReport)->Arg(0)->Arg(1)->UseRealTime();
+BENCHMARK(BM_StreamReport);
+
+BENCHMARK(BM_TopOfBookRead)->Arg(0)->Arg(1)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,83 @@
+// Order gateway throughput and round-trip latency with 1, 4 and 16 session
+// threads feeding one matching thread through the MPSC ingress ring.
+
+#include <benchmark/benchmark.h>
+#include "OrderGateway.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Gateway = OrderGateway<LimitOrderBook<PriceLadder>>;
+
+constexpr int MESSAGES = 1 << 17; // Per iteration, split across sessions
+
+std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// Every session alternates resting and cancelling its own passive orders and
+// stamps each command; latency is submit to ack seen by the session.
+void BM_GatewayRoundTrip(benchmark::State& state) {
+    const auto sessions = static_cast<SessionId>(state.range(0));
+    const int per_session = MESSAGES / static_cast<int>(sessions) / 2 * 2;
+    Gateway gateway(sessions, {}, 4096, 4096);
+    std::jthread matcher([&](std::stop_token stop) { gateway.run(stop); });
+
+    std::vector<std::uint64_t> latencies;
+    latencies.reserve(static_cast<std::size_t>(per_session) * sessions * 4);
+    OrderId base = 0;
+
+    for (auto _ : state) {
+        std::vector<std::vector<std::uint64_t>> samples(sessions);
+        std::vector<std::thread> threads;
+        for (SessionId s = 0; s < sessions; ++s) {
+            threads.emplace_back([&, s] {
+                auto& mine = samples[s];
+                mine.reserve(per_session);
+                auto poll = [&] {
+                    OrderAck ack;
+                    while (gateway.poll_ack(s, ack)) mine.push_back(now_ns() - ack.tag);
+                };
+                auto send = [&](const OrderCommand& command) {
+                    while (!gateway.submit(s, command, now_ns())) poll();
+                };
+
+                Side side = s % 2 ? Side::SELL : Side::BUY;
+                int price = s % 2 ? 10'100 : 9'900;
+                for (int i = 0; i < per_session / 2; ++i) {
+                    OrderId id = base + static_cast<OrderId>(s) * per_session + i;
+                    send({.id = id, .quantity = 1, .price = price, .type = CommandType::ADD, .side = side});
+                    send({.id = id, .type = CommandType::CANCEL, .side = side});
+                    poll();
+                }
+                while (mine.size() < static_cast<std::size_t>(per_session)) poll();
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        base += static_cast<OrderId>(per_session) * sessions;
+
+        for (const auto& mine : samples) latencies.insert(latencies.end(), mine.begin(), mine.end());
+    }
+    matcher.request_stop();
+    matcher.join();
+
+    state.SetItemsProcessed(state.iterations() * per_session * sessions);
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        auto at = [&](double q) { return static_cast<double>(latencies[static_cast<std::size_t>(q * (latencies.size() - 1))]); };
+        state.counters["p50_ns"] = at(0.50);
+        state.counters["p99_ns"] = at(0.99);
+        state.counters["p99.9_ns"] = at(0.999);
+    }
+}
+
+}  // namespace
+
+BENCHMARK(BM_GatewayRoundTrip)->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
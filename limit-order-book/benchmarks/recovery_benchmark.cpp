@@ -0,0 +1,118 @@
+// Snapshot and recovery cost for a book of N resting orders on the ladder.
+// BM_Snapshot is the whole write; BM_SnapshotCapture the part of it a
+// BookRecorder leaves on the matching thread.
+// Recovery maps the snapshot, rebuilds the book through restore_orders(), then
+// replays a journal tail of TAIL commands written after the snapshot.
+// Files go to the system temp directory.
+
+#include <benchmark/benchmark.h>
+#include "BookRecorder.h"
+#include "LimitOrderBook.h"
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+using LadderBook = LimitOrderBook<PriceLadder>;
+
+constexpr int MID = 10'000;
+constexpr int DEPTH = 1000;
+constexpr int TAIL = 100'000;
+
+BookConfig config_for(std::int64_t orders) {
+    return BookConfig{4096, static_cast<std::size_t>(orders) + TAIL};
+}
+
+std::string bench_dir(std::int64_t orders) {
+    return (std::filesystem::temp_directory_path() / ("lob_recovery_bench_" + std::to_string(orders))).string();
+}
+
+// N passive orders over DEPTH levels per side
+void fill(LadderBook& book, std::int64_t count) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> offset(1, DEPTH);
+    std::uniform_int_distribution<int> qty(1, 100);
+    for (std::int64_t i = 0; i < count; ++i) {
+        bool buy = i & 1;
+        int price = buy ? MID - offset(rng) : MID + offset(rng);
+        book.add_order({static_cast<OrderId>(i + 1), buy ? Side::BUY : Side::SELL, qty(rng), price});
+    }
+}
+
+// Writes a snapshot of N orders followed by a TAIL-command journal: adds of
+// new ids interleaved with cancels of the oldest
+void record(std::int64_t orders) {
+    std::string dir = bench_dir(orders);
+    std::filesystem::remove_all(dir);
+    auto book = std::make_unique<LadderBook>(config_for(orders));
+    fill(*book, orders);
+
+    BookRecorder recorder(*book, dir);
+    for (int i = 0; i < TAIL / 2; ++i) {
+        OrderId id = static_cast<OrderId>(orders + i + 1);
+        recorder.apply(OrderCommand{.id = id, .quantity = 10, .price = MID - 1 - i % DEPTH,
+                                    .type = CommandType::ADD, .side = Side::BUY});
+        recorder.apply(OrderCommand{.id = static_cast<OrderId>(i + 1), .type = CommandType::CANCEL});
+    }
+}
+
+void BM_Snapshot(benchmark::State& state) {
+    const std::int64_t orders = state.range(0);
+    std::string path = bench_dir(orders) + "-snapshot.bin";
+    auto book = std::make_unique<LadderBook>(config_for(orders));
+    fill(*book, orders);
+
+    for (auto _ : state) write_snapshot(*book, path);
+    state.SetItemsProcessed(state.iterations() * orders);
+    std::filesystem::remove(path);
+}
+
+// What a BookRecorder snapshot costs the matching thread: copying the
+// resting orders into a buffer for the writer thread (reused between runs)
+void BM_SnapshotCapture(benchmark::State& state) {
+    const std::int64_t orders = state.range(0);
+    auto book = std::make_unique<LadderBook>(config_for(orders));
+    fill(*book, orders);
+    std::vector<LadderBook::RestingOrder> buffer;
+
+    for (auto _ : state) {
+        buffer.clear();
+        buffer.reserve(book->order_count());
+        book->for_each_order([&buffer](const LadderBook::RestingOrder& order) { buffer.push_back(order); });
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * orders);
+}
+
+void BM_Recover(benchmark::State& state) {
+    const std::int64_t orders = state.range(0);
+    record(orders);
+    std::string dir = bench_dir(orders);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto book = std::make_unique<LadderBook>(config_for(orders));
+        state.ResumeTiming();
+
+        RecoveryStats stats = BookRecorder<LadderBook>::recover(*book, dir);
+        benchmark::DoNotOptimize(stats);
+
+        state.PauseTiming();
+        book.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * orders);
+    state.counters["tail"] = TAIL;
+    std::filesystem::remove_all(dir);
+}
+
+}
+
+BENCHMARK(BM_Snapshot)->Arg(1'000'000)->Arg(10'000'000)->Iterations(3)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SnapshotCapture)->Arg(1'000'000)->Arg(10'000'000)->Iterations(3)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Recover)->Arg(1'000'000)->Arg(10'000'000)->Iterations(3)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
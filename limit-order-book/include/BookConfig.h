@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+// Construction parameters for LimitOrderBook and its level stores.
+// Capacities size the startup preallocation; exceeding them still works but
+// costs a heap allocation (see LimitOrderBook::heap_allocations). Tick size
+// is a compile-time PriceTraits parameter, not configuration.
+struct BookConfig {
+    std::size_t initial_levels = 1024;   // Price levels per side
+    std::size_t order_capacity = 65536;  // Resting orders across both sides
+    std::size_t max_price_span = 65536;  // Ticks a tick-indexed structure may cover; farther prices are kept sparse
+};
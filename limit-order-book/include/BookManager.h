@@ -0,0 +1,124 @@
+#pragma once
+
+#include "BookConfig.h"
+#include "LimitOrderBook.h"
+#include "OrderCommand.h"
+#include "SpscRing.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+// Pins the calling thread to a CPU core. Returns false where unsupported.
+bool pin_current_thread(int core);
+
+// Owns one book per dense SymbolId and shards them across matching threads.
+//
+// Symbol s lives on shard s % num_shards. Each shard thread is pinned to its
+// own core and is the only thread that ever touches its books, so books need
+// no locks. A single router thread feeds shards through per-shard SPSC rings
+// with route(); books may be inspected directly only while stopped.
+template <typename Book = LimitOrderBook<>>
+class BookManager {
+public:
+    BookManager(std::size_t num_symbols, std::size_t num_shards,
+                const BookConfig& config = {}, std::size_t queue_capacity = 65536)
+        : num_symbols_(num_symbols)
+    {
+        shards_.reserve(num_shards);
+        for (std::size_t s = 0; s < num_shards; ++s) {
+            shards_.push_back(std::make_unique<Shard>(queue_capacity));
+        }
+        for (std::size_t symbol = 0; symbol < num_symbols; ++symbol) {
+            shards_[symbol % num_shards]->books.push_back(std::make_unique<Book>(config));
+        }
+    }
+
+    ~BookManager() { stop(); }
+
+    BookManager(const BookManager&) = delete;
+    BookManager& operator=(const BookManager&) = delete;
+
+    [[nodiscard]] std::size_t num_symbols() const { return num_symbols_; }
+    [[nodiscard]] std::size_t num_shards() const { return shards_.size(); }
+    [[nodiscard]] std::size_t shard_of(SymbolId symbol) const { return symbol % shards_.size(); }
+
+    // Spawns one matching thread per shard, shard i pinned to core first_core + i
+    void start(int first_core = 0) {
+        int cores = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        for (std::size_t s = 0; s < shards_.size(); ++s) {
+            Shard& shard = *shards_[s];
+            int core = (first_core + static_cast<int>(s)) % cores;
+            shard.thread = std::jthread([this, &shard, core](std::stop_token stop) {
+                pin_current_thread(core);
+                run(shard, stop);
+            });
+        }
+    }
+
+    // Drains every inbound ring, then joins the matching threads
+    void stop() {
+        for (auto& shard : shards_) {
+            if (shard->thread.joinable()) {
+                shard->thread.request_stop();
+                shard->thread.join();
+            }
+        }
+    }
+
+    // Router thread only. Returns false if the symbol is unknown or its
+    // shard's ring is full (caller retries; the matcher is never blocked).
+    bool route(const OrderCommand& command) {
+        if (command.symbol >= num_symbols_) return false;
+        return shards_[shard_of(command.symbol)]->inbound.try_push(command);
+    }
+
+    // Direct access; only while stopped
+    [[nodiscard]] Book& book(SymbolId symbol) {
+        return *shards_[shard_of(symbol)]->books[symbol / shards_.size()];
+    }
+
+    // Commands applied by a shard so far
+    [[nodiscard]] std::uint64_t processed(std::size_t shard) const {
+        return shards_[shard]->processed.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Shard {
+        explicit Shard(std::size_t queue_capacity) : inbound(queue_capacity) {}
+
+        SpscRing<OrderCommand> inbound;
+        std::vector<std::unique_ptr<Book>> books; // Indexed by symbol / num_shards
+        alignas(64) std::atomic<std::uint64_t> processed{0};
+        std::jthread thread;
+    };
+
+    void run(Shard& shard, std::stop_token stop) {
+        std::size_t stride = shards_.size();
+        std::uint64_t processed = 0;
+        OrderCommand command;
+
+        auto drain = [&] {
+            bool any = false;
+            while (shard.inbound.try_pop(command)) {
+                apply(*shard.books[command.symbol / stride], command);
+                ++processed;
+                any = true;
+            }
+            shard.processed.store(processed, std::memory_order_relaxed);
+            return any;
+        };
+
+        while (!stop.stop_requested()) {
+            if (!drain()) std::this_thread::yield();
+        }
+        drain();
+    }
+
+    std::size_t num_symbols_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+};
@@ -0,0 +1,317 @@
+#pragma once
+
+#include "Journal.h"
+#include "MessageFile.h"
+#include "OrderCommand.h"
+#include "Snapshot.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+struct RecorderConfig {
+    std::uint64_t journal_capacity = 1 << 22;   // records per journal file
+    std::uint64_t snapshot_interval = 1 << 20;  // accepted commands between snapshots
+    std::chrono::milliseconds flush_interval{1};
+};
+
+struct RecoveryStats {
+    std::uint64_t restored_orders = 0;   // resting orders loaded from the snapshot
+    std::uint64_t replayed_messages = 0; // journal records applied after it
+};
+
+// Drives a book and makes its state durable in dir.
+//
+// Every accepted command is appended to journal-<generation>.bin, and every
+// snapshot_interval of them the resting orders are written to snapshot.bin
+// along with the journal position they reflect. When a journal fills, the
+// command that didn't fit opens the next generation's journal, a snapshot
+// is taken, and the old journal is deleted once that snapshot is committed.
+// recover() loads the snapshot and replays the journal past it, then every
+// later generation's journal, so a crash before a rollover snapshot commits
+// loses nothing.
+//
+// Construction commits the first snapshot before any command is accepted.
+// After that the matching thread only copies the resting orders into a
+// buffer (one pass, no I/O); a background thread writes, fsyncs and renames
+// it, in the order snapshots were taken. The same thread creates and maps
+// the next generation's journal ahead of time and closes retired ones, so a
+// rollover is a pointer swap. A periodic snapshot due while the writer is
+// still busy is skipped (the journal covers the gap); explicit and rollover
+// snapshots always queue. A writer failure is rethrown on the next
+// snapshot() or flush(). Journal records are OrderCommands, so prices and
+// quantities must fit in int.
+template <typename Book>
+class BookRecorder {
+public:
+    // Starts a new generation with a snapshot of book as it stands (empty,
+    // or just recovered from dir), committed before returning, and deletes
+    // the journals it supersedes
+    BookRecorder(Book& book, std::string dir, const RecorderConfig& config = {})
+        : book_(book), dir_(std::move(dir)), config_(config)
+    {
+        std::filesystem::create_directories(dir_);
+        auto previous = read_snapshot_header(snapshot_path(dir_));
+        std::uint64_t first = previous ? previous->generation : 0;
+
+        // Past any journal recovery may have chained into
+        generation_ = previous ? first + 1 : 0;
+        while (std::filesystem::exists(journal_path(dir_, generation_))) ++generation_;
+
+        write_snapshot(book_, snapshot_path(dir_), generation_, 0);
+        for (std::uint64_t g = first; g < generation_; ++g) std::filesystem::remove(journal_path(dir_, g));
+
+        journal_ = open_journal(journal_path(dir_, generation_));
+        next_generation_ = generation_ + 1;
+        want_journal_ = true;
+        writer_ = std::jthread([this](std::stop_token stop) { write_loop(stop); });
+    }
+
+    // An unused pre-created journal is removed so the next run starts from
+    // the right generation
+    ~BookRecorder() {
+        writer_.request_stop();
+        writer_.join();
+        if (next_journal_) {
+            next_journal_.reset();
+            std::filesystem::remove(journal_path(dir_, generation_ + 1));
+        }
+    }
+
+    BookRecorder(const BookRecorder&) = delete;
+    BookRecorder& operator=(const BookRecorder&) = delete;
+
+    // Applies command to the book and journals it if accepted
+    bool apply(const OrderCommand& command) {
+        if (!::apply(book_, command)) return false;
+        if (!journal_->append(command)) [[unlikely]] rotate(command);
+        if (++since_snapshot_ == config_.snapshot_interval) [[unlikely]] {
+            since_snapshot_ = 0;
+            if (!writer_busy()) snapshot();
+        }
+        return true;
+    }
+
+    // Copies the resting orders and the journal position they reflect, and
+    // queues them for the writer thread
+    void snapshot() {
+        rethrow_writer_error();
+        queue_snapshot({});
+    }
+
+    // Blocks until every journaled command and every snapshot taken so far
+    // is on disk, and the next journal is ready
+    void flush() {
+        journal_->flush();
+        std::unique_lock lock(mutex_);
+        idle_.wait(lock, [this] { return jobs_.empty() && !writing_ && !want_journal_; });
+        lock.unlock();
+        rethrow_writer_error();
+    }
+
+    [[nodiscard]] std::uint64_t generation() const { return generation_; }
+    [[nodiscard]] const Journal& journal() const { return *journal_; }
+
+    // Rebuilds an empty book from dir: the snapshot's orders go back without
+    // matching (restore_orders()), then the journal tail and any later
+    // generations' journals are applied as they were. A missing snapshot
+    // leaves it empty.
+    static RecoveryStats recover(Book& book, const std::string& dir) {
+        RecoveryStats stats;
+        if (!read_snapshot_header(snapshot_path(dir))) return stats;
+
+        std::uint64_t generation = 0;
+        std::uint64_t journal_count = 0;
+        {
+            MappedSnapshot snapshot(snapshot_path(dir), sizeof(Record));
+            generation = snapshot.header().generation;
+            journal_count = snapshot.header().journal_count;
+            std::span<const Record> orders(static_cast<const Record*>(snapshot.records()),
+                                          snapshot.header().count);
+            book.restore_orders(orders);
+            stats.restored_orders = orders.size();
+        }
+
+        // Journals are only ever published complete, so each one that exists maps
+        for (std::uint64_t g = generation; std::filesystem::exists(journal_path(dir, g)); ++g) {
+            MappedMessageFile tail(journal_path(dir, g));
+            auto messages = tail.messages();
+            for (std::size_t i = g == generation ? journal_count : 0; i < messages.size(); ++i) {
+                ::apply(book, messages[i]);
+                ++stats.replayed_messages;
+            }
+        }
+        return stats;
+    }
+
+private:
+    using Record = typename Book::RestingOrder;
+
+    struct SnapshotJob {
+        std::vector<Record> orders;
+        std::uint64_t generation = 0;
+        std::uint64_t journal_count = 0;
+        std::string obsolete_journal;  // Deleted once this snapshot is committed
+        std::unique_ptr<Journal> retired;  // Closed by the writer before that
+    };
+
+    static std::string snapshot_path(const std::string& dir) { return dir + "/snapshot.bin"; }
+    static std::string journal_path(const std::string& dir, std::uint64_t generation) {
+        return dir + "/journal-" + std::to_string(generation) + ".bin";
+    }
+
+    std::unique_ptr<Journal> open_journal(const std::string& path) const {
+        return std::make_unique<Journal>(path, config_.journal_capacity, config_.flush_interval);
+    }
+
+    // Switches to the journal the writer prepared and starts it with the
+    // command that didn't fit, so recovery finds it there if the process dies
+    // before the rollover snapshot commits. Only that commit lets the writer
+    // delete the old journal.
+    void rotate(const OrderCommand& command) {
+        std::uint64_t old = generation_++;
+        std::unique_ptr<Journal> retired = std::move(journal_);
+        {
+            // Only a journal filling faster than one can be created waits here
+            std::unique_lock lock(mutex_);
+            idle_.wait(lock, [this] { return !want_journal_; });
+            journal_ = std::move(next_journal_);
+            next_generation_ = generation_ + 1;
+            want_journal_ = true;
+        }
+        wake_.notify_one();
+
+        // The writer couldn't create it (its error is rethrown later)
+        if (!journal_) journal_ = open_journal(journal_path(dir_, generation_));
+        journal_->append(command);
+        since_snapshot_ = 0;
+        queue_snapshot(journal_path(dir_, old), std::move(retired));
+    }
+
+    // Matching thread: the one pass over the book; the rest is the writer's
+    void queue_snapshot(std::string obsolete_journal, std::unique_ptr<Journal> retired = {}) {
+        SnapshotJob job;
+        {
+            std::lock_guard lock(mutex_);
+            if (spare_) job.orders = std::move(*spare_);
+            spare_.reset();
+        }
+        job.orders.clear();
+        job.orders.reserve(book_.order_count() + book_.pending_stops());
+        book_.for_each_order([&job](const Record& order) { job.orders.push_back(order); });
+        job.generation = generation_;
+        job.journal_count = journal_->count();
+        job.obsolete_journal = std::move(obsolete_journal);
+        job.retired = std::move(retired);
+
+        std::lock_guard lock(mutex_);
+        jobs_.push_back(std::move(job));
+        wake_.notify_one();
+    }
+
+    bool writer_busy() {
+        std::lock_guard lock(mutex_);
+        return !jobs_.empty() || writing_;
+    }
+
+    void rethrow_writer_error() {
+        std::exception_ptr error;
+        {
+            std::lock_guard lock(mutex_);
+            std::swap(error, error_);
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    // Writer thread: prepares the next journal first, since a rollover may be
+    // waiting for it, then commits queued snapshots in order; finishes the
+    // queue before stopping
+    void write_loop(std::stop_token stop) {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            wake_.wait(lock, stop, [this] { return !jobs_.empty() || want_journal_; });
+            if (want_journal_ && !stop.stop_requested()) {
+                prepare_journal(lock);
+                continue;
+            }
+            if (jobs_.empty()) return;  // Stop requested with nothing queued
+
+            SnapshotJob job = std::move(jobs_.front());
+            jobs_.pop_front();
+            writing_ = true;
+            lock.unlock();
+
+            try {
+                job.retired.reset();
+                SnapshotWriter writer(snapshot_path(dir_), sizeof(Record), job.generation, job.journal_count);
+                writer.write(job.orders.data(), job.orders.size());
+                writer.commit();
+                if (!job.obsolete_journal.empty()) std::filesystem::remove(job.obsolete_journal);
+            }
+            catch (...) {
+                std::lock_guard error_lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+
+            lock.lock();
+            writing_ = false;
+            spare_ = std::move(job.orders);
+            idle_.notify_all();
+        }
+    }
+
+    // Writer thread: creates and maps the next generation's journal under a
+    // temporary name, then renames it into place, so recovery never meets a
+    // half-created one
+    void prepare_journal(std::unique_lock<std::mutex>& lock) {
+        std::string path = journal_path(dir_, next_generation_);
+        lock.unlock();
+
+        std::unique_ptr<Journal> journal;
+        try {
+            journal = open_journal(path + ".tmp");
+            std::filesystem::rename(path + ".tmp", path);
+        }
+        catch (...) {
+            journal.reset();
+            std::lock_guard error_lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+
+        lock.lock();
+        next_journal_ = std::move(journal);
+        want_journal_ = false;
+        idle_.notify_all();
+    }
+
+    Book& book_;
+    std::string dir_;
+    RecorderConfig config_;
+    std::uint64_t generation_ = 0;
+    std::uint64_t since_snapshot_ = 0;
+    std::unique_ptr<Journal> journal_;
+
+    std::mutex mutex_;
+    std::condition_variable_any wake_;
+    std::condition_variable idle_;
+    std::deque<SnapshotJob> jobs_;
+    bool writing_ = false;
+    std::optional<std::vector<Record>> spare_;  // Last written buffer, reused by the next copy
+    std::unique_ptr<Journal> next_journal_;     // Ready for generation_ + 1
+    std::uint64_t next_generation_ = 0;
+    bool want_journal_ = false;                 // Writer owes a journal for next_generation_
+    std::exception_ptr error_;
+    std::jthread writer_;  // Last: joined before the queue it drains is destroyed
+};
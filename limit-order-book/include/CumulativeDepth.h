@@ -0,0 +1,241 @@
+#pragma once
+
+#include "BookConfig.h"
+#include "Order.h"
+#include "PriceTraits.h"
+#include "SlabPool.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Running totals of one side's resting quantity by price, so "how much can
+// an order limited to P take?" is a prefix sum instead of a walk over levels.
+//
+// Prices are keyed by distance from the front of the book (the tick for
+// asks, its negation for bids), so the best level always has the lowest key.
+// A Fenwick tree covers a window of keys [origin_, origin_ + size) anchored
+// just ahead of the best level; set() and through() are O(log size) inside
+// it. Levels beyond the window's far end sit in a sorted map, and through()
+// adds those up to its limit one by one. The window re-anchors when a better
+// level lands ahead of it, when it empties, or when the best has drifted
+// into its back half and a level lands past it; it doubles (up to
+// config.max_price_span) only if that brings the new level inside. So memory
+// follows the number of levels, never the price gap to a stray order. Sums
+// are 64-bit whatever the book's Quantity.
+template <Side S, typename Traits = IntPrices>
+class CumulativeDepth {
+public:
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+
+    CumulativeDepth() : CumulativeDepth(BookConfig{}) {}
+    explicit CumulativeDepth(const BookConfig& config)
+        : quantity_(round_up_pow2(config.initial_levels)),
+          tree_(quantity_.size() + 1),
+          max_window_(std::max(quantity_.size(), config.max_price_span)),
+          pool_(node_layout().size, node_layout().align, config.initial_levels),
+          far_(SlabAllocator<FarValue>(pool_)) {}
+
+    // far_'s allocator points at pool_
+    CumulativeDepth(const CumulativeDepth&) = delete;
+    CumulativeDepth& operator=(const CumulativeDepth&) = delete;
+
+    [[nodiscard]] std::size_t heap_allocations() const { return grow_count_ + pool_.heap_allocations(); }
+    [[nodiscard]] std::int64_t total() const { return total_; }
+
+    // Ticks the dense window covers
+    [[nodiscard]] std::size_t window() const { return quantity_.size(); }
+
+    // Levels kept outside the window
+    [[nodiscard]] std::size_t far_levels() const { return far_.size(); }
+
+    // Records the quantity now resting at price (0 once the level is gone)
+    void set(Price price, Quantity quantity) {
+        std::int64_t k = key(price);
+        if (covers(k)) {
+            store(static_cast<std::size_t>(k - origin_), quantity);
+            if (window_total_ == 0 && !far_.empty()) move_window(far_.begin()->first, quantity_.size());
+            return;
+        }
+        if (quantity == 0) {
+            if (auto it = far_.find(k); it != far_.end()) {
+                total_ -= it->second;
+                far_.erase(it);
+            }
+            return;
+        }
+
+        if (window_total_ == 0) {
+            move_window(k, quantity_.size());
+        }
+        else if (k < origin_) {
+            // New best: keep the window's levels in it if it can grow to hold them
+            std::int64_t worst = origin_ + static_cast<std::int64_t>(occupied_through(window_total_));
+            if (!anchor(k, worst)) move_window(k, quantity_.size());
+        }
+        else {
+            std::int64_t best = origin_ + static_cast<std::int64_t>(occupied_through(1));
+            if (!anchor(best, k) && best - origin_ >= static_cast<std::int64_t>(quantity_.size() / 2)) {
+                move_window(best, quantity_.size());
+            }
+        }
+
+        if (covers(k)) {
+            store(static_cast<std::size_t>(k - origin_), quantity);
+        }
+        else {
+            auto [it, inserted] = far_.try_emplace(k, 0);
+            total_ += quantity - it->second;
+            it->second = quantity;
+        }
+    }
+
+    // Quantity an aggressor limited to limit can reach on this side: asks at
+    // or below it, bids at or above it
+    [[nodiscard]] std::int64_t through(Price limit) const {
+        std::int64_t k = key(limit);
+        if (k < origin_) return 0;
+        if (covers(k)) return prefix(static_cast<std::size_t>(k - origin_) + 1);
+
+        std::int64_t sum = window_total_;
+        for (auto it = far_.begin(); it != far_.end() && it->first <= k; ++it) sum += it->second;
+        return sum;
+    }
+
+private:
+    using FarValue = std::pair<const std::int64_t, std::int64_t>;
+    template <typename Allocator>
+    using FarMap = std::map<std::int64_t, std::int64_t, std::less<std::int64_t>, Allocator>;
+
+    static std::size_t round_up_pow2(std::size_t n) {
+        std::size_t size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    // Size and alignment of far_'s node type, measured once through a LayoutProbe
+    static const BlockLayout& node_layout() {
+        static const BlockLayout layout = [] {
+            BlockLayout measured;
+            FarMap<LayoutProbe<FarValue>> probe{LayoutProbe<FarValue>(measured)};
+            probe.try_emplace(0, 0);
+            return measured;
+        }();
+        return layout;
+    }
+
+    [[nodiscard]] static std::int64_t key(Price price) {
+        auto tick = static_cast<std::int64_t>(Traits::to_tick(price));
+        if constexpr (S == Side::SELL) return tick;
+        else return -tick;
+    }
+
+    [[nodiscard]] bool covers(std::int64_t k) const {
+        return k >= origin_ && k - origin_ < static_cast<std::int64_t>(quantity_.size());
+    }
+
+    void store(std::size_t i, std::int64_t quantity) {
+        std::int64_t delta = quantity - quantity_[i];
+        if (delta == 0) return;
+        quantity_[i] = quantity;
+        window_total_ += delta;
+        total_ += delta;
+        for (std::size_t j = i + 1; j < tree_.size(); j += j & -j) tree_[j] += delta;
+    }
+
+    // Sum of the first n slots
+    [[nodiscard]] std::int64_t prefix(std::size_t n) const {
+        std::int64_t sum = 0;
+        for (; n > 0; n -= n & -n) sum += tree_[n];
+        return sum;
+    }
+
+    // First slot whose prefix sum reaches target (0 < target <= window_total_):
+    // with target 1 the best level, with window_total_ the worst in the window
+    [[nodiscard]] std::size_t occupied_through(std::int64_t target) const {
+        std::size_t pos = 0;
+        for (std::size_t step = quantity_.size(); step > 0; step >>= 1) {
+            if (pos + step < tree_.size() && tree_[pos + step] < target) {
+                pos += step;
+                target -= tree_[pos];
+            }
+        }
+        return pos;
+    }
+
+    // Anchors the window at best, doubling it if that brings reach inside
+    // without passing max_window_. Returns false (window untouched) if reach
+    // would still fall outside.
+    bool anchor(std::int64_t best, std::int64_t reach) {
+        std::size_t size = quantity_.size();
+        while (size * 2 <= max_window_ && static_cast<std::int64_t>(size - size / 4) <= reach - best) size <<= 1;
+        if (static_cast<std::int64_t>(size - size / 4) <= reach - best) return false;
+        move_window(best, size);
+        return true;
+    }
+
+    // Re-bases the window a quarter of its size ahead of best (which has the
+    // lowest key of any level), spilling levels it no longer covers into
+    // far_ and taking back those it now does. O(size + levels moved).
+    void move_window(std::int64_t best, std::size_t size) {
+        std::int64_t origin = best - static_cast<std::int64_t>(size / 4);
+        auto end = origin + static_cast<std::int64_t>(size);
+        if (window_total_ != 0) {
+            for (std::size_t i = 0; i < quantity_.size(); ++i) {
+                std::int64_t k = origin_ + static_cast<std::int64_t>(i);
+                if (quantity_[i] != 0 && k >= end) far_.emplace(k, quantity_[i]);
+            }
+        }
+
+        if (size != quantity_.size()) {
+            quantity_.resize(size);
+            tree_.resize(size + 1);
+            ++grow_count_;
+        }
+
+        // Slot i moves to i + shift; everything shifted out was spilled above
+        std::int64_t shift = origin_ - origin;
+        if (window_total_ == 0 || (shift < 0 ? -shift : shift) >= static_cast<std::int64_t>(size)) {
+            std::fill(quantity_.begin(), quantity_.end(), 0);
+        }
+        else if (shift > 0) {
+            std::shift_right(quantity_.begin(), quantity_.end(), shift);
+            std::fill(quantity_.begin(), quantity_.begin() + shift, 0);
+        }
+        else if (shift < 0) {
+            std::shift_left(quantity_.begin(), quantity_.end(), -shift);
+            std::fill(quantity_.end() + shift, quantity_.end(), 0);
+        }
+        origin_ = origin;
+
+        for (auto it = far_.lower_bound(origin); it != far_.end() && it->first < end;) {
+            quantity_[static_cast<std::size_t>(it->first - origin)] = it->second;
+            it = far_.erase(it);
+        }
+
+        // Linear-time build: each slot pushes its partial sum to its parent
+        std::fill(tree_.begin(), tree_.end(), 0);
+        window_total_ = 0;
+        for (std::size_t j = 1; j <= size; ++j) {
+            window_total_ += quantity_[j - 1];
+            tree_[j] += quantity_[j - 1];
+            std::size_t parent = j + (j & -j);
+            if (parent <= size) tree_[parent] += tree_[j];
+        }
+    }
+
+    std::vector<std::int64_t> quantity_; // Per key, window slot i = origin_ + i
+    std::vector<std::int64_t> tree_;     // Fenwick tree, 1-based
+    std::size_t max_window_;
+    std::int64_t origin_ = 0;
+    std::int64_t window_total_ = 0;
+    std::int64_t total_ = 0;
+    std::size_t grow_count_ = 0;
+
+    SlabPool pool_;
+    FarMap<SlabAllocator<FarValue>> far_; // Levels past the window's far end, by key
+};
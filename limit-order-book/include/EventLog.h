@@ -0,0 +1,222 @@
+#pragma once
+
+#include "ExecutionReport.h"
+#include "Order.h"
+#include "SpscRing.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Hot-path stamp for log records: the x86 time-stamp counter (no kernel or
+// vDSO call), steady_clock nanoseconds elsewhere. EventLog converts it to
+// steady_clock nanoseconds on its own thread when formatting.
+inline std::uint64_t log_clock() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+enum class LogKind : std::uint8_t {
+    REPORT,      // An execution report
+    BOOK_BEGIN,  // Start of a book dump; levels follow, asks then bids, best first
+    BOOK_LEVEL,  // One level of a book dump
+    BOOK_END,    // End of a book dump
+    MARK         // Short fixed text
+};
+
+// Fixed-size binary log record. The matching thread only fills one in and
+// copies it into its ring; turning it into text happens on the log thread.
+struct LogRecord {
+    struct Level {
+        std::int64_t price;
+        std::int64_t quantity;
+        std::uint32_t order_count;
+    };
+
+    std::uint64_t timestamp;  // log_clock() ticks; steady_clock nanoseconds once formatted
+    LogKind kind;
+    Side side;                // BOOK_LEVEL
+    std::uint8_t _padding[6];
+    union {
+        ExecutionReport report;
+        Level level;
+        std::uint64_t sequence;  // BOOK_BEGIN: depth sequence at the dump
+        char text[40];           // MARK, NUL-padded
+    };
+};
+
+static_assert(sizeof(LogRecord) == 56, "LogRecord should stay under a cache line");
+static_assert(std::is_trivially_copyable_v<LogRecord>);
+
+// What a channel does with a record that finds its ring full
+enum class LogOverflow : std::uint8_t {
+    BLOCK,  // Wake the log thread and yield until there is room; nothing is lost
+    DROP    // Discard the record and count it; the caller never waits
+};
+
+class EventLog;
+
+// One producer thread's ring into an EventLog. A BLOCK channel (the default)
+// loses nothing: a full ring stalls the caller until the log thread catches
+// up, and stalls() counts how often. A DROP channel never waits, so a burst
+// that overflows it (a book dump, say) comes out with records missing, and
+// dropped() says how many.
+class LogChannel {
+public:
+    LogChannel(std::size_t capacity, EventLog& owner, LogOverflow overflow)
+        : ring_(capacity), owner_(&owner), overflow_(overflow) {}
+
+    // Returns false only if a DROP channel discarded the record
+    bool log(LogRecord record) {
+        record.timestamp = log_clock();
+        if (ring_.try_push(record)) return true;
+        return on_full(record);
+    }
+
+    bool report(const ExecutionReport& report) {
+        LogRecord record{};
+        record.kind = LogKind::REPORT;
+        record.report = report;
+        return log(record);
+    }
+
+    // Copies up to 39 characters of text
+    bool mark(const char* text) {
+        LogRecord record{};
+        record.kind = LogKind::MARK;
+        std::strncpy(record.text, text, sizeof(record.text) - 1);
+        return log(record);
+    }
+
+    // Book dumps, driven by LimitOrderBook::log_book()
+    void begin_book(std::uint64_t sequence) {
+        LogRecord record{};
+        record.kind = LogKind::BOOK_BEGIN;
+        record.sequence = sequence;
+        log(record);
+    }
+
+    void level(Side side, std::int64_t price, std::int64_t quantity, std::uint32_t order_count) {
+        LogRecord record{};
+        record.kind = LogKind::BOOK_LEVEL;
+        record.side = side;
+        record.level = {price, quantity, order_count};
+        log(record);
+    }
+
+    void end_book() {
+        LogRecord record{};
+        record.kind = LogKind::BOOK_END;
+        log(record);
+    }
+
+    [[nodiscard]] LogOverflow overflow() const { return overflow_; }
+    [[nodiscard]] std::size_t dropped() const { return dropped_; }
+    [[nodiscard]] std::size_t stalls() const { return stalls_; }
+
+private:
+    friend class EventLog;
+
+    bool on_full(const LogRecord& record);
+
+    SpscRing<LogRecord> ring_;
+    EventLog* owner_;
+    LogOverflow overflow_;
+    std::size_t dropped_ = 0;
+    std::size_t stalls_ = 0;
+};
+
+// Asynchronous text log fed by per-thread binary rings.
+//
+// Each producing thread takes its own channel() once and logs into it
+// lock-free (a counter read and a ring push). A background thread drains
+// every channel each poll_interval, or sooner when a blocked channel wakes
+// it, and formats the records to path, one line per record, with
+// timestamps converted to steady_clock nanoseconds. Lines from one channel
+// keep their order; channels are interleaved by drain pass, not by
+// timestamp. Throws std::runtime_error if the file can't be opened.
+class EventLog {
+public:
+    explicit EventLog(const std::string& path, std::size_t ring_capacity = 1 << 16,
+                      std::chrono::milliseconds poll_interval = std::chrono::milliseconds(1));
+    ~EventLog();
+
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    // A new ring for the calling thread; the reference stays valid for the
+    // log's lifetime. Takes a lock, so call it once per thread up front.
+    LogChannel& channel(LogOverflow overflow = LogOverflow::BLOCK);
+
+    // Writes everything logged so far to the file before returning
+    void flush();
+
+    // Records formatted to the file so far
+    [[nodiscard]] std::uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+
+private:
+    friend class LogChannel;
+
+    // Producer side: a blocked channel asks for an early drain pass
+    void wake();
+
+    void drain_loop(std::stop_token stop);
+    void drain();
+    void calibrate();
+    void format(std::size_t channel, const LogRecord& record);
+
+    std::ofstream out_;
+    std::size_t ring_capacity_;
+    std::chrono::milliseconds poll_interval_;
+    std::atomic<std::uint64_t> written_{0};
+
+    std::mutex channels_mutex_;  // Also makes the drain single-consumer
+    std::vector<std::unique_ptr<LogChannel>> channels_;
+
+    // log_clock() to steady_clock: the pair taken at construction, and the
+    // rate measured from it to the latest drain pass
+    std::uint64_t anchor_ticks_ = 0;
+    std::uint64_t anchor_ns_ = 0;
+    double ns_per_tick_ = 1.0;
+
+    std::atomic<bool> wake_requested_{false};
+    std::condition_variable_any wake_;
+    std::jthread drainer_;
+};
+
+// Execution-report sink that writes every report to a log channel, for an
+// audit trail that costs the matcher a ring push per report. Needs a BLOCK
+// channel, so the trail is never thinned: throws std::invalid_argument for
+// a DROP one.
+class LogSink {
+public:
+    explicit LogSink(LogChannel& channel) : channel_(&channel) {
+        if (channel.overflow() != LogOverflow::BLOCK) {
+            throw std::invalid_argument("LogSink needs a blocking LogChannel");
+        }
+    }
+
+    void operator()(const ExecutionReport& report) { channel_->report(report); }
+
+private:
+    LogChannel* channel_;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Order.h"
+#include "PriceTraits.h"
+#include "SpscRing.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+enum class ExecType : std::uint8_t {
+    FILL,          // Order completely filled
+    PARTIAL_FILL,  // Order traded, quantity still open
+    REST,          // Remainder placed on the book
+    CANCEL,        // Resting order removed
+    MODIFY,        // Resting order quantity changed
+    REJECT,        // add_order refused the order
+    EXPIRE,        // Unfilled market / IOC / FOK quantity dropped instead of resting
+    PENDING,       // Stop order accepted, waiting for its trigger
+    TRIGGER        // Stop order triggered; what it becomes is reported next
+};
+
+// Fixed-size POD event emitted by the matcher. A trade produces one report
+// for each side, resting order first. Price and quantity types follow the
+// book's PriceTraits; ExecutionReport is the int form.
+template <typename Traits>
+struct BasicExecutionReport {
+    OrderId order_id;                          // Order this report is about
+    OrderId contra_id;                         // Other side of a fill, 0 otherwise
+    typename Traits::Price price;              // Trade price, or the order's price
+    typename Traits::Quantity quantity;        // Traded / rested / cancelled / new quantity
+    typename Traits::Quantity leaves_quantity; // Open quantity after this event
+    ExecType type;
+    Side side;
+    std::uint8_t _padding[2];
+};
+
+using ExecutionReport = BasicExecutionReport<IntPrices>;
+
+static_assert(sizeof(ExecutionReport) == 32, "ExecutionReport should fill half a cache line");
+static_assert(std::is_trivially_copyable_v<ExecutionReport>);
+
+inline std::ostream& operator<<(std::ostream& os, ExecType type) {
+    switch (type) {
+        case ExecType::FILL:         os << "FILL"; break;
+        case ExecType::PARTIAL_FILL: os << "PARTIAL_FILL"; break;
+        case ExecType::REST:         os << "REST"; break;
+        case ExecType::CANCEL:       os << "CANCEL"; break;
+        case ExecType::MODIFY:       os << "MODIFY"; break;
+        case ExecType::REJECT:       os << "REJECT"; break;
+        case ExecType::EXPIRE:       os << "EXPIRE"; break;
+        case ExecType::PENDING:      os << "PENDING"; break;
+        case ExecType::TRIGGER:      os << "TRIGGER"; break;
+    }
+    return os;
+}
+
+template <typename Traits>
+std::ostream& operator<<(std::ostream& os, const BasicExecutionReport<Traits>& report) {
+    os << report.type << " #" << report.order_id << " " << report.side << " "
+       << report.quantity << " at " << report.price << " (leaves " << report.leaves_quantity << ")";
+    if (report.contra_id) os << " vs #" << report.contra_id;
+    return os;
+}
+
+// Default sink: reports compile away entirely
+struct NullSink {
+    template <typename Report>
+    void operator()(const Report&) const {}
+};
+
+// Hands reports to another core through an SPSC ring. Never blocks the
+// matcher: if the consumer falls behind and the ring is full the report is
+// dropped and counted.
+class RingSink {
+public:
+    explicit RingSink(SpscRing<ExecutionReport>& ring) : ring_(&ring) {}
+
+    void operator()(const ExecutionReport& report) {
+        if (!ring_->try_push(report)) ++dropped_;
+    }
+
+    [[nodiscard]] std::size_t dropped() const { return dropped_; }
+
+private:
+    SpscRing<ExecutionReport>* ring_;
+    std::size_t dropped_ = 0;
+};
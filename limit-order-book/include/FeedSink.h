@@ -0,0 +1,56 @@
+#pragma once
+
+#include "ExecutionReport.h"
+#include "OrderCommand.h"
+#include <vector>
+
+// Turns a matching book's reports into the order-by-order feed a venue
+// publishes for it: rests become adds, fills of resting orders become
+// executes, cancels and modifies pass through. Replaying that feed through
+// apply_feed() into an empty book rebuilds the same resting orders.
+//
+// Aggressor fills, rejects, expiries and stop triggers have no feed message.
+// An iceberg's reserve isn't in its REST report, so it shows as a plain
+// order of its full size; cancels of pending stops come out as deletes of
+// ids the feed never added.
+class FeedSink {
+public:
+    explicit FeedSink(std::vector<OrderCommand>& out, SymbolId symbol = 0) : out_(&out), symbol_(symbol) {}
+
+    void operator()(const ExecutionReport& report) {
+        switch (report.type) {
+            case ExecType::REST:
+                emit(report, CommandType::ADD);
+                break;
+            case ExecType::FILL:
+            case ExecType::PARTIAL_FILL:
+                // Matches report the resting order first, then the aggressor;
+                // execute_order() prints reports without a contra
+                if (report.contra_id && aggressor_next_) {
+                    aggressor_next_ = false;
+                    break;
+                }
+                aggressor_next_ = report.contra_id != 0;
+                emit(report, CommandType::EXECUTE);
+                break;
+            case ExecType::CANCEL:
+                emit(report, CommandType::CANCEL);
+                break;
+            case ExecType::MODIFY:
+                emit(report, CommandType::MODIFY);
+                break;
+            default:
+                break;
+        }
+    }
+
+private:
+    void emit(const ExecutionReport& report, CommandType type) {
+        out_->push_back(OrderCommand{report.order_id, symbol_, report.quantity, report.price, type,
+                                     report.side, OrderType::LIMIT, 0, 0, 0});
+    }
+
+    std::vector<OrderCommand>* out_;
+    SymbolId symbol_;
+    bool aggressor_next_ = false;
+};
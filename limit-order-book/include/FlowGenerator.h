@@ -0,0 +1,45 @@
+#pragma once
+
+#include "OrderCommand.h"
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Shape of the synthetic order flow. Ratios are per message; whatever is
+// left after add/cancel/modify is execute.
+struct FlowConfig {
+    std::uint32_t num_symbols = 1;
+    int mid_price = 10'000;          // Starting mid, in ticks
+    int max_offset = 50;             // Passive adds land within this many ticks of mid
+    double add_ratio = 0.50;
+    double cancel_ratio = 0.42;
+    double modify_ratio = 0.06;
+    double marketable_ratio = 0.05;  // Fraction of adds priced through the touch
+    std::uint64_t seed = 42;
+};
+
+// Deterministic synthetic order flow with exchange-like proportions: adds
+// cluster near a slowly drifting mid, cancels and amends target live orders.
+class FlowGenerator {
+public:
+    explicit FlowGenerator(const FlowConfig& config = {});
+
+    OrderCommand next();
+
+private:
+    struct SymbolState {
+        int mid;
+        std::vector<OrderId> live; // Ids believed resting (fills aren't simulated)
+    };
+
+    OrderCommand make_add(SymbolId symbol, SymbolState& state);
+    OrderId take_live(SymbolState& state, bool remove);
+
+    FlowConfig config_;
+    std::mt19937_64 rng_;
+    std::uniform_real_distribution<double> unit_{0.0, 1.0};
+    std::geometric_distribution<int> offset_{0.15};
+    std::uniform_int_distribution<int> quantity_{1, 500};
+    std::vector<SymbolState> symbols_;
+    OrderId next_id_ = 1;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "MessageFile.h"
+#include "OrderCommand.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+// Memory-mapped append-only log of accepted commands.
+//
+// The file is a message file (MessageFile.h) pre-sized for capacity records
+// and mapped shared, so it replays with MappedMessageFile or lob_replay. The
+// matching thread's append() is a memcpy into the mapping plus one release
+// store; a background thread msyncs newly appended records every
+// flush_interval and only then advances the header's count, so the count
+// never covers a record that isn't on disk. Throws std::runtime_error if the
+// file can't be created or mapped.
+class Journal {
+public:
+    Journal(const std::string& path, std::uint64_t capacity,
+            std::chrono::milliseconds flush_interval = std::chrono::milliseconds(1));
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    // Matching thread only. Returns false once capacity records are written.
+    bool append(const OrderCommand& command) {
+        std::uint64_t n = appended_.load(std::memory_order_relaxed);
+        if (n == capacity_) [[unlikely]] return false;
+        std::memcpy(records_ + n, &command, sizeof(OrderCommand));
+        appended_.store(n + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Writes everything appended so far to disk before returning
+    void flush();
+
+    [[nodiscard]] std::uint64_t count() const { return appended_.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t durable() const { return durable_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::uint64_t capacity() const { return capacity_; }
+
+private:
+    void flush_loop(std::stop_token stop);
+
+    int fd_ = -1;
+    std::byte* data_ = nullptr;
+    std::size_t size_ = 0;
+    MessageFileHeader* header_ = nullptr;
+    OrderCommand* records_ = nullptr;
+    std::uint64_t capacity_;
+    std::chrono::milliseconds flush_interval_;
+
+    alignas(64) std::atomic<std::uint64_t> appended_{0};
+    alignas(64) std::atomic<std::uint64_t> durable_{0};
+
+    std::mutex flush_mutex_;
+    std::condition_variable_any wake_;
+    std::jthread flusher_;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hierarchical occupancy bitset.
+//
+// Layer 0 holds one bit per slot; each bit of layer k+1 says whether the
+// matching 64-bit word of layer k is non-zero. Finding the next or previous
+// set bit therefore touches at most two words per layer: climb until a word
+// has a candidate, then descend with tzcnt/lzcnt. Three layers cover 262144
+// slots, so a search is a handful of word operations regardless of how far
+// apart the occupied slots are.
+class LevelBitmap {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit LevelBitmap(std::size_t size) : size_(size) {
+        std::size_t words = size;
+        do {
+            words = (words + 63) / 64;
+            layers_.emplace_back(words, 0);
+        } while (words > 1);
+    }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+    [[nodiscard]] bool test(std::size_t i) const {
+        return layers_[0][i >> 6] & bit(i);
+    }
+
+    void set(std::size_t i) {
+        for (auto& layer : layers_) {
+            std::uint64_t& word = layer[i >> 6];
+            bool was_empty = word == 0;
+            word |= bit(i);
+            if (!was_empty) break;
+            i >>= 6;
+        }
+    }
+
+    void clear(std::size_t i) {
+        for (auto& layer : layers_) {
+            std::uint64_t& word = layer[i >> 6];
+            word &= ~bit(i);
+            if (word != 0) break;
+            i >>= 6;
+        }
+    }
+
+    // Lowest set index >= i, or npos
+    [[nodiscard]] std::size_t find_next(std::size_t i) const {
+        if (i >= size_) return npos;
+
+        for (std::size_t l = 0; l < layers_.size(); ++l) {
+            std::size_t word = i >> 6;
+            if (word >= layers_[l].size()) return npos;
+
+            std::uint64_t bits = layers_[l][word] & (~std::uint64_t{0} << (i & 63));
+            if (bits) {
+                std::size_t idx = (word << 6) | std::countr_zero(bits);
+                while (l-- > 0) idx = (idx << 6) | std::countr_zero(layers_[l][idx]);
+                return idx;
+            }
+            i = word + 1; // Next word of this layer is the next bit one layer up
+        }
+        return npos;
+    }
+
+    // Highest set index <= i, or npos
+    [[nodiscard]] std::size_t find_prev(std::size_t i) const {
+        if (i >= size_) i = size_ - 1;
+
+        for (std::size_t l = 0; l < layers_.size(); ++l) {
+            std::size_t word = i >> 6;
+            std::uint64_t bits = layers_[l][word] & (~std::uint64_t{0} >> (63 - (i & 63)));
+            if (bits) {
+                std::size_t idx = (word << 6) | (63 - std::countl_zero(bits));
+                while (l-- > 0) idx = (idx << 6) | (63 - std::countl_zero(layers_[l][idx]));
+                return idx;
+            }
+            if (word == 0) return npos;
+            i = word - 1;
+        }
+        return npos;
+    }
+
+private:
+    static std::uint64_t bit(std::size_t i) { return std::uint64_t{1} << (i & 63); }
+
+    std::size_t size_;
+    std::vector<std::vector<std::uint64_t>> layers_; // layers_[0] is the finest
+};
@@ -1,19 +1,776 @@
 #pragma once
 
+#include "BookConfig.h"
+#include "CumulativeDepth.h"
+#include "ExecutionReport.h"
+#include "MarketDepth.h"
 #include "Order.h"
-#include <map>
-#include <functional>
+#include "OrderIndex.h"
+#include "PriceLevel.h"
+#include "MapLevels.h"
+#include "PriceLadder.h"
+#include "SeqLock.h"
+#include "SlabPool.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+// Order-level book with price-time priority.
+// Each price holds a FIFO queue of individual orders; an id -> node index
+// lets cancel and modify reach any resting order without walking its level.
+//
+// Levels selects how each side stores its price levels:
+//   MapLevels   - std::map keyed by price (sparse, any price range)
+//   PriceLadder - flat tick-indexed array with best-price cursors
+//
+// Order nodes, level nodes and the id index are all preallocated from the
+// BookConfig capacities, so matching, resting and cancelling make no heap
+// allocations in steady state.
+//
+// Traits (PriceTraits) fixes the price and quantity types and the tick size
+// at compile time; the default IntPrices keeps int prices on a tick of 1.
+//
+// Orders are limit, market, IOC or FOK (OrderType), and resting limit orders
+// may be icebergs. Each side's resting quantity by price is also kept in a
+// CumulativeDepth, so a FOK is accepted or killed with one prefix sum.
+//
+// Stop and stop-limit orders wait in a second pair of level stores keyed by
+// trigger price, ordered the way trades reach them. After each add or
+// execute, every stop the event's trades crossed is taken from the front of
+// those stores (O(triggered) plus the level erases) and entered in a fixed
+// order: buy stops lowest trigger first, then sell stops highest first, FIFO
+// within a trigger price; stops their trades trigger in turn follow.
+//
+// Every fill, rest, cancel, modify and reject is passed to Sink as a Report
+// (ExecutionReport for IntPrices). Sink is any callable taking const Report&;
+// NullSink compiles the reports away, RingSink forwards them to another
+// thread through an SPSC ring. Inside add_orders() reports are buffered and
+// handed over in chunks, as one std::span<const Report> call when Sink
+// accepts that.
+//
+// The top DEPTH_LEVELS levels of each side are kept as an L2 view, updated in
+// place as levels change. depth() is the current view and depth_delta() the
+// levels the last call changed, for publishing to market-data consumers.
+// Whenever an event moves the best bid or offer it is also republished
+// through a SeqLock, which strategy threads may read concurrently via
+// top_of_book(); everything else is for the matching thread only.
+//
+// The same book doubles as an L3 feed builder: insert_order() rests an add
+// without matching, and cancel/modify/execute never match, so a venue's
+// order-by-order feed (apply_feed) is reproduced exactly as published.
+template <template <Side, typename> class Levels = MapLevels, typename Sink = NullSink, typename Traits = IntPrices>
 class LimitOrderBook {
 public:
-    LimitOrderBook() = default;
-    void add_order(Order order);
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+    using Order = BasicOrder<Price, Quantity>;
+    using RestingOrder = BasicRestingOrder<Price, Quantity>;
+    using Report = BasicExecutionReport<Traits>;
+    using DepthSnapshot = BasicDepthSnapshot<Traits>;
+    using DepthDelta = BasicDepthDelta<Traits>;
+    using TopOfBook = BasicTopOfBook<Traits>;
+
+    explicit LimitOrderBook(const BookConfig& config = {}, Sink sink = Sink{})
+        : bids(config),
+          asks(config),
+          bid_liquidity_(config),
+          ask_liquidity_(config),
+          buy_stops_(config),
+          sell_stops_(config),
+          nodes_(config.order_capacity),
+          orders_(config.order_capacity),
+          sink_(std::move(sink)) {}
+
+    LimitOrderBook(const LimitOrderBook&) = delete;
+    LimitOrderBook& operator=(const LimitOrderBook&) = delete;
+
+    // Matches against the opposite side. A limit order rests any remainder;
+    // market and IOC remainders and killed FOKs are reported as EXPIRE; a
+    // stop waits (PENDING) for a later trade to trigger it. Returns false
+    // (book untouched) for non-positive quantity, negative display quantity,
+    // an off-tick limit or stop price, or an id already in the book.
+    bool add_order(Order order);
+
+    // add_order() over a burst (auction uncross, replay). Prefetches the id
+    // slot and price level a few orders ahead, keeps both best prices in
+    // locals instead of re-reading the level stores, and publishes top of
+    // book once for the whole batch; depth_delta() is then a full refresh.
+    // Returns the number accepted.
+    std::size_t add_orders(std::span<const Order> orders);
+
+    // Builder mode: rests a limit order exactly as given, without matching,
+    // for replaying a venue's feed where crossing has already happened (a
+    // locked or crossed book stays that way). Returns false for anything
+    // add_order() would refuse and for any other order type.
+    bool insert_order(const Order& order);
+
+    // Recovery: puts orders back as for_each_order() listed them, limits
+    // resting without matching (icebergs showing the slice they showed) and
+    // stops parked without triggering, so a snapshot of any book (a crossed
+    // builder-mode one included) comes back unchanged. Publishes top of book
+    // once. Returns the number accepted; other order types are rejected.
+    std::size_t restore_orders(std::span<const RestingOrder> orders);
+
+    // Removes a resting order or pending stop. Returns false if the id is
+    // not in the book.
+    bool cancel_order(OrderId id);
+
+    // Sets a resting order's quantity. A decrease keeps queue position, an
+    // increase moves it to the back of its level, zero cancels.
+    bool modify_order(OrderId id, Quantity quantity);
+
+    // Fills up to quantity of a resting order outside the matching loop, e.g.
+    // a trade printed by an auction or another venue. Returns false if the id
+    // is not resting. Like a match, the trade can trigger stops.
+    bool execute_order(OrderId id, Quantity quantity);
+
+    [[nodiscard]] std::optional<Price> best_bid() const;
+    [[nodiscard]] std::optional<Price> best_ask() const;
+    [[nodiscard]] Quantity volume_at(Side side, Price price) const;
+    [[nodiscard]] std::size_t order_count() const { return orders_.size() - stop_count_; }
+    [[nodiscard]] std::size_t pending_stops() const { return stop_count_; }
+
+    // Number of orders ahead of id at its level (O(position))
+    [[nodiscard]] std::optional<std::size_t> queue_position(OrderId id) const;
+
+    // Visits every resting order as a RestingOrder: bids then asks, best
+    // level first, oldest first within a level, then pending stops in
+    // trigger order. restore_orders() on them rebuilds the book exactly;
+    // adding them as Orders rebuilds it with the same queue priority, but
+    // an iceberg then comes back with a full visible slice.
+    template <typename F>
+    void for_each_order(F&& f) const {
+        auto visit = [&f](const Level& level) {
+            for (const Node* node = level.front(); node; node = node->next) {
+                bool stop = node->type != OrderType::LIMIT;
+                f(RestingOrder{{node->id, node->side, node->quantity + node->reserve, node->price,
+                                node->type, node->peak, stop ? level.price() : Price{}},
+                               node->quantity});
+            }
+        };
+        bids.for_each(visit);
+        asks.for_each(visit);
+        buy_stops_.for_each(visit);
+        sell_stops_.for_each(visit);
+    }
+
+    // Heap allocations made since construction (pool slabs, table and ladder
+    // growth). Stays at zero while the book is within its configured capacity.
+    [[nodiscard]] std::size_t heap_allocations() const {
+        return bids.heap_allocations() + asks.heap_allocations()
+             + buy_stops_.heap_allocations() + sell_stops_.heap_allocations()
+             + bid_liquidity_.heap_allocations() + ask_liquidity_.heap_allocations()
+             + nodes_.heap_allocations() + orders_.heap_allocations();
+    }
+
+    [[nodiscard]] Sink& sink() { return sink_; }
+
+    [[nodiscard]] const DepthSnapshot& depth() const { return depth_.snapshot(); }
+    [[nodiscard]] const DepthDelta& depth_delta() const { return depth_.delta(); }
+
+    // Imbalance, microprice and depth-weighted mid as of the last event, from
+    // aggregates the depth view keeps as levels change (no walk of the book)
+    [[nodiscard]] BookAnalytics analytics() const { return depth_.analytics(); }
+
+    // Safe to load from any thread while the book is being driven
+    [[nodiscard]] const SeqLock<TopOfBook>& top_of_book() const { return top_; }
+
     void print_book() const;
 
+    // print_book() for the hot path: hands every level to log (a LogChannel)
+    // as fixed-size records, asks then bids, best first, for the EventLog
+    // thread to format
+    template <typename Log>
+    void log_book(Log& log) const {
+        log.begin_book(depth_.snapshot().sequence);
+        auto visit = [&log](Side side) {
+            return [&log, side](const Level& level) {
+                log.level(side, level.price(), level.total_quantity(), static_cast<std::uint32_t>(level.order_count()));
+            };
+        };
+        asks.for_each(visit(Side::SELL));
+        bids.for_each(visit(Side::BUY));
+        log.end_book();
+    }
+
 private:
-    using Bids = std::map<int, int, std::greater<int>>;
-    using Asks = std::map<int, int, std::less<int>>;
+    using Level = BasicPriceLevel<Traits>;
+    using Node = BasicOrderNode<Traits>;
+    using Bids = Levels<Side::BUY, Traits>;
+    using Asks = Levels<Side::SELL, Traits>;
+
+    // Pending stops by trigger price, nearest the market first: rising trades
+    // reach buy stops lowest first (ask order), falling ones reach sell stops
+    // highest first (bid order)
+    using BuyStops = Levels<Side::SELL, Traits>;
+    using SellStops = Levels<Side::BUY, Traits>;
+
+    static constexpr Price NO_BID = std::numeric_limits<Price>::min();
+    static constexpr Price NO_ASK = std::numeric_limits<Price>::max();
+
+    [[nodiscard]] static bool is_stop(OrderType type) {
+        return type == OrderType::STOP || type == OrderType::STOP_LIMIT;
+    }
+
+    // Reports and returns false if add_order() must refuse order
+    bool validate(const Order& order) {
+        bool priced = order.type != OrderType::MARKET && order.type != OrderType::STOP;
+        if (order.quantity <= 0 || order.display_quantity < 0
+            || (priced && !Traits::on_tick(order.price))
+            || (is_stop(order.type) && !Traits::on_tick(order.stop_price)) || orders_.find(order.id)) {
+            report(ExecType::REJECT, order.id, 0, order.side, order.price, order.quantity, 0);
+            return false;
+        }
+        return true;
+    }
+
+    // add_order() without the event bracketing
+    bool submit(Order order);
+
+    // Queues a stop on its trigger level
+    void park(const Order& order);
+
+    // Enters every stop crossed by trades since the last call, then any they
+    // trigger in turn. Returns whether any were triggered.
+    bool trigger_stops();
+
+    void note_trade(Price price) {
+        trade_low_ = std::min(trade_low_, price);
+        trade_high_ = std::max(trade_high_, price);
+    }
+
+    template <typename Opposite>
+    void match(Order& order, Opposite& levels);
+
+    // Queues order's remainder on its level; visible overrides the slice an
+    // iceberg shows (0 shows a full one)
+    template <typename Same>
+    void rest(const Order& order, Same& levels, Quantity visible = 0);
+
+    void erase_level(Side side, Level& level);
+
+    // Stores the new best bid/offer for readers if the event changed it
+    void publish_top() {
+        TopOfBook top = depth_.top();
+        if (top.bid_price == published_.bid_price && top.bid_quantity == published_.bid_quantity
+            && top.ask_price == published_.ask_price && top.ask_quantity == published_.ask_quantity) return;
+        published_ = top;
+        top_.store(top);
+    }
+
+    // Pushes a level's new state into the depth view and the cumulative
+    // depth; the level store must already reflect it (level is nullptr once
+    // erased). Hidden iceberg reserve counts toward FOK liquidity only.
+    void update_depth(Side side, Price price, const Level* level) {
+        Quantity quantity = level ? level->total_quantity() : 0;
+        Quantity reachable = level ? quantity + level->reserve_quantity() : 0;
+        auto order_count = static_cast<std::uint32_t>(level ? level->order_count() : 0);
+        depth_.update(side, price, quantity, order_count, [this, side](Price from) {
+            return side == Side::BUY ? bids.next_worse(from) : asks.next_worse(from);
+        });
+        if (side == Side::BUY) bid_liquidity_.set(price, reachable);
+        else ask_liquidity_.set(price, reachable);
+    }
+
+    void report(ExecType type, OrderId id, OrderId contra_id, Side side,
+                Price price, Quantity quantity, Quantity leaves_quantity) {
+        Report report{id, contra_id, price, quantity, leaves_quantity, type, side, {}};
+        if constexpr (!std::is_same_v<Sink, NullSink>) {
+            if (batching_) {
+                pending_[pending_count_++] = report;
+                if (pending_count_ == pending_.size()) flush_reports();
+                return;
+            }
+        }
+        sink_(report);
+    }
+
+    void flush_reports() {
+        if constexpr (std::is_invocable_v<Sink&, std::span<const Report>>) {
+            if (pending_count_) sink_(std::span<const Report>(pending_.data(), pending_count_));
+        }
+        else {
+            for (std::size_t i = 0; i < pending_count_; ++i) sink_(pending_[i]);
+        }
+        pending_count_ = 0;
+    }
+
+    static constexpr std::size_t PREFETCH_DISTANCE = 4;
+    static constexpr std::size_t REPORT_BATCH = 64;
 
     Bids bids;
     Asks asks;
-};
\ No newline at end of file
+    CumulativeDepth<Side::BUY, Traits> bid_liquidity_;
+    CumulativeDepth<Side::SELL, Traits> ask_liquidity_;
+    BuyStops buy_stops_;
+    SellStops sell_stops_;
+    std::size_t stop_count_ = 0;
+    Price trade_low_ = NO_ASK;  // Trade price range since the last trigger check
+    Price trade_high_ = NO_BID;
+    ObjectPool<Node> nodes_;
+    OrderIndex<Node> orders_;
+    Sink sink_;
+    BasicMarketDepth<Traits> depth_;
+    TopOfBook published_{};
+    SeqLock<TopOfBook> top_;
+
+    bool batching_ = false;
+    std::size_t pending_count_ = 0;
+    std::array<Report, REPORT_BATCH> pending_;
+};
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+bool LimitOrderBook<Levels, Sink, Traits>::add_order(Order order) {
+    depth_.begin_event();
+    if (!submit(order)) return false;
+    trigger_stops();
+    publish_top();
+    return true;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+bool LimitOrderBook<Levels, Sink, Traits>::submit(Order order) {
+    if (!validate(order)) return false;
+    if (is_stop(order.type)) {
+        park(order);
+        return true;
+    }
+
+    Price price = order.price;
+    if (order.type == OrderType::MARKET) {
+        order.price = order.side == Side::BUY ? std::numeric_limits<Price>::max() : std::numeric_limits<Price>::min();
+    }
+    else if (order.type == OrderType::FOK) {
+        std::int64_t reachable = order.side == Side::BUY ? ask_liquidity_.through(order.price)
+                                                         : bid_liquidity_.through(order.price);
+        if (reachable < order.quantity) {
+            report(ExecType::EXPIRE, order.id, 0, order.side, price, order.quantity, 0);
+            return true;
+        }
+    }
+
+    if (order.side == Side::BUY) match(order, asks);
+    else match(order, bids);
+    if (order.quantity == 0) return true;
+
+    if (order.type != OrderType::LIMIT) {
+        report(ExecType::EXPIRE, order.id, 0, order.side, price, order.quantity, 0);
+    }
+    else if (order.side == Side::BUY) {
+        rest(order, bids);
+    }
+    else {
+        rest(order, asks);
+    }
+    return true;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+std::size_t LimitOrderBook<Levels, Sink, Traits>::add_orders(std::span<const Order> orders) {
+    depth_.begin_batch();
+    batching_ = true;
+
+    // Only matching moves the opposite best and only resting improves the same side
+    Price best_bid = bids.best() ? bids.best()->price() : NO_BID;
+    Price best_ask = asks.best() ? asks.best()->price() : NO_ASK;
+
+    std::size_t accepted = 0;
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        if (i + PREFETCH_DISTANCE < orders.size()) {
+            const Order& ahead = orders[i + PREFETCH_DISTANCE];
+            orders_.prefetch(ahead.id);
+            if (ahead.side == Side::BUY) bids.prefetch(ahead.price);
+            else asks.prefetch(ahead.price);
+        }
+
+        Order order = orders[i];
+        if (order.type != OrderType::LIMIT) {
+            accepted += submit(order);
+            trigger_stops();
+            best_bid = bids.best() ? bids.best()->price() : NO_BID;
+            best_ask = asks.best() ? asks.best()->price() : NO_ASK;
+            continue;
+        }
+        if (!validate(order)) continue;
+        ++accepted;
+
+        bool crossed;
+        if (order.side == Side::BUY) {
+            crossed = order.price >= best_ask;
+            if (crossed) {
+                match(order, asks);
+                best_ask = asks.best() ? asks.best()->price() : NO_ASK;
+            }
+            if (order.quantity > 0) {
+                rest(order, bids);
+                best_bid = std::max(best_bid, order.price);
+            }
+        }
+        else {
+            crossed = order.price <= best_bid;
+            if (crossed) {
+                match(order, bids);
+                best_bid = bids.best() ? bids.best()->price() : NO_BID;
+            }
+            if (order.quantity > 0) {
+                rest(order, asks);
+                best_ask = std::min(best_ask, order.price);
+            }
+        }
+
+        // Triggered stops can move either side
+        if (crossed && trigger_stops()) {
+            best_bid = bids.best() ? bids.best()->price() : NO_BID;
+            best_ask = asks.best() ? asks.best()->price() : NO_ASK;
+        }
+    }
+
+    flush_reports();
+    batching_ = false;
+    publish_top();
+    return accepted;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+bool LimitOrderBook<Levels, Sink, Traits>::insert_order(const Order& order) {
+    depth_.begin_event();
+    if (order.type != OrderType::LIMIT) {
+        report(ExecType::REJECT, order.id, 0, order.side, order.price, order.quantity, 0);
+        return false;
+    }
+    if (!validate(order)) return false;
+
+    if (order.side == Side::BUY) rest(order, bids);
+    else rest(order, asks);
+    publish_top();
+    return true;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+std::size_t LimitOrderBook<Levels, Sink, Traits>::restore_orders(std::span<const RestingOrder> orders) {
+    depth_.begin_batch();
+    batching_ = true;
+
+    std::size_t accepted = 0;
+    for (std::size_t i = 0; i < orders.size(); ++i) {
+        if (i + PREFETCH_DISTANCE < orders.size()) {
+            const Order& ahead = orders[i + PREFETCH_DISTANCE];
+            orders_.prefetch(ahead.id);
+            if (ahead.side == Side::BUY) bids.prefetch(ahead.price);
+            else asks.prefetch(ahead.price);
+        }
+
+        const RestingOrder& order = orders[i];
+        if (order.type != OrderType::LIMIT && !is_stop(order.type)) {
+            report(ExecType::REJECT, order.id, 0, order.side, order.price, order.quantity, 0);
+            continue;
+        }
+        if (!validate(order)) continue;
+        ++accepted;
+
+        if (is_stop(order.type)) park(order);
+        else if (order.side == Side::BUY) rest(order, bids, order.visible);
+        else rest(order, asks, order.visible);
+    }
+
+    flush_reports();
+    batching_ = false;
+    publish_top();
+    return accepted;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+template <typename Opposite>
+void LimitOrderBook<Levels, Sink, Traits>::match(Order& order, Opposite& levels) {
+    Side contra_side = order.side == Side::BUY ? Side::SELL : Side::BUY;
+    while (order.quantity > 0) {
+        Level* level = levels.best();
+        if (!level) break;
+        if (order.side == Side::BUY ? order.price < level->price() : order.price > level->price()) break;
+
+        // Fill resting orders oldest first
+        while (order.quantity > 0 && !level->empty()) {
+            Node* resting = level->front();
+            Quantity traded_vol = std::min(resting->quantity, order.quantity);
+
+            order.quantity -= traded_vol;
+            level->reduce(resting, traded_vol);
+
+            Quantity leaves = resting->quantity + resting->reserve;
+            report(leaves ? ExecType::PARTIAL_FILL : ExecType::FILL, resting->id, order.id,
+                   resting->side, level->price(), traded_vol, leaves);
+            report(order.quantity ? ExecType::PARTIAL_FILL : ExecType::FILL, order.id, resting->id,
+                   order.side, level->price(), traded_vol, order.quantity);
+
+            if (resting->quantity == 0) {
+                if (resting->reserve) {
+                    level->refresh(resting);
+                }
+                else {
+                    level->remove(resting);
+                    orders_.erase(resting->id);
+                    nodes_.destroy(resting);
+                }
+            }
+        }
+
+        Price price = level->price();
+        note_trade(price);
+        if (level->empty()) {
+            levels.erase(*level);
+            update_depth(contra_side, price, nullptr);
+        }
+        else {
+            update_depth(contra_side, price, level);
+        }
+    }
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+template <typename Same>
+void LimitOrderBook<Levels, Sink, Traits>::rest(const Order& order, Same& levels, Quantity visible) {
+    Level& level = levels.level_for(order.price);
+
+    Quantity shown = order.display_quantity ? std::min(order.display_quantity, order.quantity) : order.quantity;
+    if (visible > 0) shown = std::min(shown, visible);
+    Node* node = nodes_.create(order.id, order.side, order.price, shown, order.quantity - shown, order.display_quantity);
+    level.push_back(node);
+    orders_.insert(order.id, node);
+    update_depth(order.side, order.price, &level);
+
+    report(ExecType::REST, order.id, 0, order.side, order.price, order.quantity, order.quantity);
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+void LimitOrderBook<Levels, Sink, Traits>::park(const Order& order) {
+    Level& level = order.side == Side::BUY ? buy_stops_.level_for(order.stop_price)
+                                           : sell_stops_.level_for(order.stop_price);
+
+    Node* node = nodes_.create(order.id, order.side, order.price, order.quantity, Quantity{0}, order.display_quantity);
+    node->type = order.type;
+    level.push_back(node);
+    orders_.insert(order.id, node);
+    ++stop_count_;
+
+    report(ExecType::PENDING, order.id, 0, order.side, order.stop_price, order.quantity, order.quantity);
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+bool LimitOrderBook<Levels, Sink, Traits>::trigger_stops() {
+    bool triggered = false;
+    while (trade_low_ <= trade_high_) {
+        Price low = trade_low_;
+        Price high = trade_high_;
+        trade_low_ = NO_ASK;
+        trade_high_ = NO_BID;
+        if (stop_count_ == 0) break;
+
+        // Detach every crossed trigger level whole, in entry order
+        Node* head = nullptr;
+        Node* tail = nullptr;
+        auto take = [&](auto& stops, auto crossed) {
+            for (Level* level = stops.best(); level && crossed(level->price()); level = stops.best()) {
+                auto [first, last] = level->release();
+                if (tail) tail->next = first;
+                else head = first;
+                tail = last;
+                stops.erase(*level);
+            }
+        };
+        take(buy_stops_, [high](Price trigger) { return trigger <= high; });
+        take(sell_stops_, [low](Price trigger) { return trigger >= low; });
+
+        // Trades made here widen the range again for the next pass
+        while (head) {
+            Node* node = head;
+            head = node->next;
+
+            Order order{node->id, node->side, node->quantity + node->reserve, node->price,
+                        node->type == OrderType::STOP ? OrderType::MARKET : OrderType::LIMIT, node->peak};
+            orders_.erase(node->id);
+            nodes_.destroy(node);
+            --stop_count_;
+            triggered = true;
+
+            report(ExecType::TRIGGER, order.id, 0, order.side, order.price, order.quantity, order.quantity);
+            submit(order);
+        }
+    }
+    return triggered;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+bool LimitOrderBook<Levels, Sink, Traits>::cancel_order(OrderId id) {
+    depth_.begin_event();
+    Node* node = orders_.find(id);
+    if (!node) return false;
+
+    Level* level = node->level;
+    level->remove(node);
+    orders_.erase(id);
+
+    if (is_stop(node->type)) {
+        if (level->empty()) {
+            if (node->side == Side::BUY) buy_stops_.erase(*level);
+            else sell_stops_.erase(*level);
+        }
+        --stop_count_;
+        report(ExecType::CANCEL, id, 0, node->side, node->price, node->quantity + node->reserve, 0);
+        nodes_.destroy(node);
+        return true;
+    }
+
+    if (level->empty()) {
+        erase_level(node->side, *level);
+        update_depth(node->side, node->price, nullptr);
+    }
+    else {
+        update_depth(node->side, node->price, level);
+    }
+
+    report(ExecType::CANCEL, id, 0, node->side, node->price, node->quantity + node->reserve, 0);
+    nodes_.destroy(node);
+    publish_top();
+    return true;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+bool LimitOrderBook<Levels, Sink, Traits>::modify_order(OrderId id, Quantity quantity) {
+    if (quantity <= 0) return cancel_order(id);
+
+    depth_.begin_event();
+    Node* node = orders_.find(id);
+    if (!node) return false;
+
+    Level* level = node->level;
+    Quantity open = node->quantity + node->reserve;
+
+    if (quantity < open) {
+        // An iceberg gives up reserve first, so its visible slice keeps its place
+        Quantity cut = open - quantity;
+        Quantity from_reserve = std::min(cut, node->reserve);
+        level->reduce_reserve(node, from_reserve);
+        level->reduce(node, cut - from_reserve);
+    }
+    else if (quantity > open) {
+        // Size increase forfeits time priority
+        level->remove(node);
+        node->quantity = node->peak ? std::min(node->peak, quantity) : quantity;
+        node->reserve = quantity - node->quantity;
+        level->push_back(node);
+    }
+
+    report(ExecType::MODIFY, id, 0, node->side, node->price, quantity, quantity);
+    if (is_stop(node->type)) return true;
+    update_depth(node->side, node->price, level);
+    publish_top();
+    return true;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+bool LimitOrderBook<Levels, Sink, Traits>::execute_order(OrderId id, Quantity quantity) {
+    depth_.begin_event();
+    if (quantity <= 0) return false;
+
+    Node* node = orders_.find(id);
+    if (!node || is_stop(node->type)) return false;
+
+    Level* level = node->level;
+    Quantity traded_vol = std::min(quantity, node->quantity);
+    level->reduce(node, traded_vol);
+    Quantity leaves = node->quantity + node->reserve;
+    report(leaves ? ExecType::PARTIAL_FILL : ExecType::FILL, id, 0,
+           node->side, node->price, traded_vol, leaves);
+
+    if (node->quantity == 0) {
+        if (node->reserve) {
+            level->refresh(node);
+        }
+        else {
+            level->remove(node);
+            orders_.erase(id);
+        }
+    }
+    if (level->empty()) {
+        erase_level(node->side, *level);
+        update_depth(node->side, node->price, nullptr);
+    }
+    else {
+        update_depth(node->side, node->price, level);
+    }
+    note_trade(node->price);
+    if (node->quantity == 0) nodes_.destroy(node);
+    trigger_stops();
+    publish_top();
+    return true;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+void LimitOrderBook<Levels, Sink, Traits>::erase_level(Side side, Level& level) {
+    if (side == Side::BUY) bids.erase(level);
+    else asks.erase(level);
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+auto LimitOrderBook<Levels, Sink, Traits>::best_bid() const -> std::optional<Price> {
+    const Level* level = bids.best();
+    if (!level) return std::nullopt;
+    return level->price();
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+auto LimitOrderBook<Levels, Sink, Traits>::best_ask() const -> std::optional<Price> {
+    const Level* level = asks.best();
+    if (!level) return std::nullopt;
+    return level->price();
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+auto LimitOrderBook<Levels, Sink, Traits>::volume_at(Side side, Price price) const -> Quantity {
+    const Level* level = side == Side::BUY ? bids.find(price) : asks.find(price);
+    return level ? level->total_quantity() : 0;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+std::optional<std::size_t> LimitOrderBook<Levels, Sink, Traits>::queue_position(OrderId id) const {
+    const Node* order = orders_.find(id);
+    if (!order) return std::nullopt;
+
+    std::size_t ahead = 0;
+    for (const Node* node = order->prev; node; node = node->prev) ++ahead;
+    return ahead;
+}
+
+template <template <Side, typename> class Levels, typename Sink, typename Traits>
+void LimitOrderBook<Levels, Sink, Traits>::print_book() const {
+    std::cout << "--- ORDER BOOK ---" << std::endl;
+
+    // Asks print worst to best so the spread sits in the middle
+    std::vector<const Level*> ask_levels;
+    asks.for_each([&](const Level& level) { ask_levels.push_back(&level); });
+
+    std::cout << " ASKS (Price: Qty)" << std::endl;
+    for (auto it = ask_levels.rbegin(); it != ask_levels.rend(); ++it) {
+        std::cout << "(" << (*it)->price() << ": " << (*it)->total_quantity() << ")" << std::endl;
+    }
+
+    std::cout << " BIDS (Price: Qty)" << std::endl;
+    bids.for_each([](const Level& level) {
+        std::cout << "(" << level.price() << ": " << level.total_quantity() << ")" << std::endl;
+    });
+
+    std::cout << "---------------------" << std::endl;
+
+}
+
+// Both int backends and the 64-bit ladder are compiled once in LimitOrderBook.cpp
+extern template class LimitOrderBook<MapLevels>;
+extern template class LimitOrderBook<PriceLadder>;
+extern template class LimitOrderBook<PriceLadder, NullSink, WidePrices>;
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "BookConfig.h"
+#include "PriceLevel.h"
+#include "SlabPool.h"
+#include <functional>
+#include <map>
+#include <type_traits>
+#include <utility>
+
+// One side of the book as a red-black tree of price levels, best price first.
+// Tree nodes never move, so orders can hold raw pointers to their level.
+// Nodes come from a slab sized for config.initial_levels, in blocks the size
+// of the library's node type, so creating and erasing levels in steady state
+// never reaches operator new.
+template <Side S, typename Traits = IntPrices>
+class MapLevels {
+public:
+    using Price = typename Traits::Price;
+    using Level = BasicPriceLevel<Traits>;
+
+    MapLevels() : MapLevels(BookConfig{}) {}
+    explicit MapLevels(const BookConfig& config)
+        : pool_(node_layout().size, node_layout().align, config.initial_levels),
+          levels_(SlabAllocator<Value>(pool_)) {}
+
+    // The tree's allocator points at pool_
+    MapLevels(const MapLevels&) = delete;
+    MapLevels& operator=(const MapLevels&) = delete;
+
+    [[nodiscard]] std::size_t heap_allocations() const { return pool_.heap_allocations(); }
+
+    [[nodiscard]] bool empty() const { return levels_.empty(); }
+
+    [[nodiscard]] Level* best() {
+        return levels_.empty() ? nullptr : &levels_.begin()->second;
+    }
+    [[nodiscard]] const Level* best() const {
+        return levels_.empty() ? nullptr : &levels_.begin()->second;
+    }
+
+    [[nodiscard]] const Level* find(Price price) const {
+        auto it = levels_.find(price);
+        return it == levels_.end() ? nullptr : &it->second;
+    }
+
+    // Best level strictly worse than price, or nullptr
+    [[nodiscard]] const Level* next_worse(Price price) const {
+        auto it = levels_.upper_bound(price);
+        return it == levels_.end() ? nullptr : &it->second;
+    }
+
+    // No-op: reaching a tree node is the lookup itself
+    void prefetch(Price) const {}
+
+    // Existing level at price, or a new empty one
+    Level& level_for(Price price) {
+        return levels_.try_emplace(price, price).first->second;
+    }
+
+    // Drops an emptied level; erasing the best level skips the tree search
+    void erase(Level& level) {
+        auto first = levels_.begin();
+        if (&first->second == &level) levels_.erase(first);
+        else levels_.erase(level.price());
+    }
+
+    // Visits levels best to worst
+    template <typename F>
+    void for_each(F&& f) const {
+        for (const auto& [price, level] : levels_) f(level);
+    }
+
+private:
+    using Compare = std::conditional_t<S == Side::BUY, std::greater<Price>, std::less<Price>>;
+    using Value = std::pair<const Price, Level>;
+
+    template <typename Allocator>
+    using Tree = std::map<Price, Level, Compare, Allocator>;
+
+    // Size and alignment of the tree's node type, measured once by building
+    // a one-level tree through a LayoutProbe
+    static const BlockLayout& node_layout() {
+        static const BlockLayout layout = [] {
+            BlockLayout measured;
+            Tree<LayoutProbe<Value>> probe{LayoutProbe<Value>(measured)};
+            probe.try_emplace(Price{}, Price{});
+            return measured;
+        }();
+        return layout;
+    }
+
+    SlabPool pool_;
+    Tree<SlabAllocator<Value>> levels_;
+};
@@ -0,0 +1,242 @@
+#pragma once
+
+#include "Order.h"
+#include "PriceTraits.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+inline constexpr std::size_t DEPTH_LEVELS = 10;
+
+// One aggregated price level as published to market-data consumers
+template <typename Traits>
+struct BasicDepthLevel {
+    typename Traits::Price price;
+    typename Traits::Quantity quantity;  // 0 in a delta: level left the top-N view
+    std::uint32_t order_count;
+};
+
+// Top-N levels per side, best first
+template <typename Traits>
+struct BasicDepthSnapshot {
+    using DepthLevel = BasicDepthLevel<Traits>;
+
+    std::uint64_t sequence = 0;  // Bumped once per book event that changed the view
+    std::uint8_t bid_count = 0;
+    std::uint8_t ask_count = 0;
+    std::array<DepthLevel, DEPTH_LEVELS> bids{};
+    std::array<DepthLevel, DEPTH_LEVELS> asks{};
+};
+
+template <typename Traits>
+struct BasicDepthUpdate {
+    using DepthLevel = BasicDepthLevel<Traits>;
+    Side side;
+    DepthLevel level;
+};
+
+// Levels of the top-N view changed by one book event, one entry per price.
+// If an event touches more levels than fit (a deep sweep), full_refresh is
+// set and consumers should take the snapshot instead.
+template <typename Traits>
+struct BasicDepthDelta {
+    using DepthUpdate = BasicDepthUpdate<Traits>;
+    static constexpr std::size_t CAPACITY = 4 * DEPTH_LEVELS;
+
+    std::uint64_t sequence = 0;
+    bool full_refresh = false;
+    std::uint8_t count = 0;
+    std::array<DepthUpdate, CAPACITY> updates{};
+};
+
+// Best bid and offer; a quantity of 0 marks an empty side
+template <typename Traits>
+struct BasicTopOfBook {
+    std::uint64_t sequence;  // DepthSnapshot::sequence it was taken from
+    typename Traits::Price bid_price;
+    typename Traits::Quantity bid_quantity;
+    typename Traits::Price ask_price;
+    typename Traits::Quantity ask_quantity;
+};
+
+// Order-book signals after the latest event. Prices are in the book's raw
+// price units (PriceTraits::to_double converts); microprice and
+// weighted_mid are NaN while either side is empty.
+struct BookAnalytics {
+    double imbalance;    // (bid - ask) / (bid + ask) quantity at the touch, in [-1, 1]
+    double microprice;   // Touch prices weighted by the opposite side's quantity
+    double weighted_mid; // Midpoint of each side's volume-weighted price over the top-N view
+};
+
+// Incrementally maintained top-N depth.
+//
+// The book reports every level whose quantity changed; changes deeper than
+// the N-th level return after one comparison, so keeping the view costs
+// O(changed levels) rather than a walk of the book per event. Each side's
+// quantity and price x quantity over the view are kept as running sums,
+// adjusted as levels enter, change and leave, so analytics() is O(1).
+template <typename Traits>
+class BasicMarketDepth {
+public:
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+    using DepthLevel = BasicDepthLevel<Traits>;
+    using DepthSnapshot = BasicDepthSnapshot<Traits>;
+    using DepthDelta = BasicDepthDelta<Traits>;
+    using TopOfBook = BasicTopOfBook<Traits>;
+
+    [[nodiscard]] const DepthSnapshot& snapshot() const { return snapshot_; }
+    [[nodiscard]] const DepthDelta& delta() const { return delta_; }
+
+    [[nodiscard]] TopOfBook top() const {
+        TopOfBook top{snapshot_.sequence, 0, 0, 0, 0};
+        if (snapshot_.bid_count) {
+            top.bid_price = snapshot_.bids[0].price;
+            top.bid_quantity = snapshot_.bids[0].quantity;
+        }
+        if (snapshot_.ask_count) {
+            top.ask_price = snapshot_.asks[0].price;
+            top.ask_quantity = snapshot_.asks[0].quantity;
+        }
+        return top;
+    }
+
+    [[nodiscard]] BookAnalytics analytics() const {
+        constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+        BookAnalytics result{0.0, NaN, NaN};
+
+        double bid = snapshot_.bid_count ? static_cast<double>(snapshot_.bids[0].quantity) : 0.0;
+        double ask = snapshot_.ask_count ? static_cast<double>(snapshot_.asks[0].quantity) : 0.0;
+        if (bid + ask > 0) result.imbalance = (bid - ask) / (bid + ask);
+        if (!snapshot_.bid_count || !snapshot_.ask_count) return result;
+
+        result.microprice = (static_cast<double>(snapshot_.bids[0].price) * ask
+                             + static_cast<double>(snapshot_.asks[0].price) * bid) / (bid + ask);
+        double bid_vwap = static_cast<double>(notional_[0]) / static_cast<double>(quantity_[0]);
+        double ask_vwap = static_cast<double>(notional_[1]) / static_cast<double>(quantity_[1]);
+        result.weighted_mid = (bid_vwap + ask_vwap) / 2;
+        return result;
+    }
+
+    // Starts a new book event; the delta then describes only this event
+    void begin_event() {
+        delta_.count = 0;
+        delta_.full_refresh = false;
+        changed_ = false;
+    }
+
+    // Starts an event spanning many orders (a batch add). Per-level deltas
+    // would mostly overflow, so the delta is a full refresh from the outset.
+    void begin_batch() {
+        begin_event();
+        delta_.full_refresh = true;
+    }
+
+    // The level at price now holds quantity across order_count orders
+    // (quantity 0: level gone). The level store must already reflect the
+    // change. next_worse(price) returns the best level worse than price
+    // (or nullptr), used to pull a level into view when one leaves.
+    template <typename NextWorse>
+    void update(Side side, Price price, Quantity quantity, std::uint32_t order_count, NextWorse&& next_worse) {
+        auto& levels = side == Side::BUY ? snapshot_.bids : snapshot_.asks;
+        std::uint8_t& count = side == Side::BUY ? snapshot_.bid_count : snapshot_.ask_count;
+
+        std::size_t i = 0;
+        while (i < count && better(side, levels[i].price, price)) ++i;
+        bool present = i < count && levels[i].price == price;
+
+        if (quantity > 0) {
+            if (present) {
+                accumulate(side, price, quantity - levels[i].quantity);
+                levels[i].quantity = quantity;
+                levels[i].order_count = order_count;
+                record(side, levels[i]);
+                return;
+            }
+            if (i == DEPTH_LEVELS) return; // Deeper than the view
+
+            // Insert at i; a full view pushes its worst level out
+            if (count == DEPTH_LEVELS) {
+                const DepthLevel& worst = levels[DEPTH_LEVELS - 1];
+                accumulate(side, worst.price, -worst.quantity);
+                record(side, {worst.price, 0, 0});
+            }
+            else {
+                ++count;
+            }
+            for (std::size_t j = count - 1; j > i; --j) levels[j] = levels[j - 1];
+            levels[i] = {price, quantity, order_count};
+            accumulate(side, price, quantity);
+            record(side, levels[i]);
+            return;
+        }
+
+        if (!present) return;
+
+        bool was_full = count == DEPTH_LEVELS;
+        accumulate(side, price, -levels[i].quantity);
+        for (std::size_t j = i; j + 1 < count; ++j) levels[j] = levels[j + 1];
+        --count;
+        record(side, {price, 0, 0});
+
+        // Refill the freed bottom slot from the book
+        if (was_full) {
+            if (const auto* next = next_worse(levels[count - 1].price)) {
+                levels[count] = {next->price(), next->total_quantity(), static_cast<std::uint32_t>(next->order_count())};
+                accumulate(side, next->price(), next->total_quantity());
+                record(side, levels[count]);
+                ++count;
+            }
+        }
+    }
+
+private:
+    static bool better(Side side, Price a, Price b) {
+        return side == Side::BUY ? a > b : a < b;
+    }
+
+    // Exact whatever the price width: 128-bit price x quantity
+    void accumulate(Side side, Price price, Quantity delta) {
+        std::size_t s = side == Side::BUY ? 0 : 1;
+        quantity_[s] += delta;
+        notional_[s] += static_cast<__int128>(price) * delta;
+    }
+
+    void record(Side side, const DepthLevel& level) {
+        if (!changed_) {
+            changed_ = true;
+            snapshot_.sequence = delta_.sequence = snapshot_.sequence + 1;
+        }
+        if (delta_.full_refresh) return;
+
+        // Latest state wins for a price touched twice in one event
+        for (std::size_t k = 0; k < delta_.count; ++k) {
+            auto& update = delta_.updates[k];
+            if (update.side == side && update.level.price == level.price) {
+                update.level = level;
+                return;
+            }
+        }
+        if (delta_.count == DepthDelta::CAPACITY) {
+            delta_.full_refresh = true;
+            return;
+        }
+        delta_.updates[delta_.count++] = {side, level};
+    }
+
+    DepthSnapshot snapshot_;
+    DepthDelta delta_;
+    bool changed_ = false;
+
+    // Per side (bids, asks) over the view
+    std::array<std::int64_t, 2> quantity_{};
+    std::array<__int128, 2> notional_{};
+};
+
+using DepthLevel = BasicDepthLevel<IntPrices>;
+using DepthSnapshot = BasicDepthSnapshot<IntPrices>;
+using DepthUpdate = BasicDepthUpdate<IntPrices>;
+using DepthDelta = BasicDepthDelta<IntPrices>;
+using TopOfBook = BasicTopOfBook<IntPrices>;
+using MarketDepth = BasicMarketDepth<IntPrices>;
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "OrderCommand.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <span>
+#include <string>
+
+// Binary order-flow capture.
+//
+// A 32-byte header followed by `count` fixed-width records, native byte
+// order. Each record is laid out exactly as OrderCommand, so a mapped file
+// is replayed in place: no parsing, no copying.
+struct MessageFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint32_t num_symbols;
+    std::uint32_t _reserved;
+    std::uint64_t count;
+};
+
+static_assert(sizeof(MessageFileHeader) == 32, "Header must keep records 8-byte aligned");
+
+inline constexpr char MESSAGE_FILE_MAGIC[8] = {'L', 'O', 'B', 'M', 'S', 'G', '\0', '\0'};
+inline constexpr std::uint32_t MESSAGE_FILE_VERSION = 2; // 2: 32-byte records with order type
+
+// Streams records to a new file; the header's count is patched on close()
+class MessageFileWriter {
+public:
+    MessageFileWriter(const std::string& path, std::uint32_t num_symbols);
+    ~MessageFileWriter();
+
+    MessageFileWriter(const MessageFileWriter&) = delete;
+    MessageFileWriter& operator=(const MessageFileWriter&) = delete;
+
+    void write(const OrderCommand& command);
+    void close();
+
+    [[nodiscard]] std::uint64_t count() const { return header_.count; }
+
+private:
+    std::ofstream out_;
+    MessageFileHeader header_;
+};
+
+// Read-only memory mapping of a message file. Throws std::runtime_error if
+// the file can't be mapped or isn't a valid capture.
+class MappedMessageFile {
+public:
+    explicit MappedMessageFile(const std::string& path);
+    ~MappedMessageFile();
+
+    MappedMessageFile(const MappedMessageFile&) = delete;
+    MappedMessageFile& operator=(const MappedMessageFile&) = delete;
+
+    [[nodiscard]] std::span<const OrderCommand> messages() const { return messages_; }
+    [[nodiscard]] std::uint32_t num_symbols() const { return num_symbols_; }
+
+private:
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::uint32_t num_symbols_ = 0;
+    std::span<const OrderCommand> messages_;
+};
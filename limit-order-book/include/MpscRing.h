@@ -0,0 +1,101 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Bounded multi-producer, single-consumer lock-free ring.
+//
+// Each slot carries a sequence number that says whose turn it is: a producer
+// claims slot head by CAS on the shared head counter when the slot's sequence
+// equals head, writes the item, then publishes by storing head + 1. The
+// consumer takes the slot once it sees that value and hands it back to the
+// producers one lap later by storing tail + capacity. Producers never wait on
+// one another beyond a failed CAS, and a full ring fails the push instead of
+// blocking.
+template <typename T>
+class MpscRing {
+public:
+    explicit MpscRing(std::size_t capacity)
+        : capacity_(round_up_pow2(capacity)),
+          mask_(capacity_ - 1),
+          slots_(std::make_unique<Slot[]>(capacity_))
+    {
+        for (std::size_t i = 0; i < capacity_; ++i) slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const { return capacity_; }
+
+    // Any thread: returns false if full, never blocks
+    bool try_push(const T& item) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[head & mask_];
+            std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<std::intptr_t>(sequence - head);
+            if (lag == 0) {
+                if (head_.compare_exchange_weak(head, head + 1, std::memory_order_relaxed)) break;
+            }
+            else if (lag < 0) {
+                return false; // Slot still holds the item from one lap ago
+            }
+            else {
+                head = head_.load(std::memory_order_relaxed);
+            }
+        }
+        slot->value = item;
+        slot->sequence.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only: returns false if empty
+    bool try_pop(T& out) {
+        Slot& slot = slots_[tail_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) return false;
+        out = slot.value;
+        slot.sequence.store(tail_ + capacity_, std::memory_order_release);
+        ++tail_;
+        return true;
+    }
+
+    // Consumer only: passes up to max ready items to f in order, returns the count
+    template <typename F>
+    std::size_t drain(F&& f, std::size_t max) {
+        std::size_t count = 0;
+        for (; count < max; ++count) {
+            Slot& slot = slots_[tail_ & mask_];
+            if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) break;
+            f(slot.value);
+            slot.sequence.store(tail_ + capacity_, std::memory_order_release);
+            ++tail_;
+        }
+        return count;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static std::size_t round_up_pow2(std::size_t n) {
+        std::size_t size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    std::size_t capacity_;
+    std::size_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+
+    // Contended by producers
+    alignas(64) std::atomic<std::size_t> head_{0};
+
+    // Consumer line
+    alignas(64) std::size_t tail_ = 0;
+};
@@ -1,15 +1,51 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
 
-enum class Side {
+using OrderId = std::uint64_t;
+
+enum class Side : std::uint8_t {
     BUY, SELL
 };
 
-struct Order {
+// How an incoming order treats quantity it can't fill on arrival
+enum class OrderType : std::uint8_t {
+    LIMIT,  // Rests at its price
+    MARKET, // Trades at any price, remainder expires; price is ignored
+    IOC,    // Immediate-or-cancel: trades up to its price, remainder expires
+    FOK,    // Fill-or-kill: trades its whole quantity up to its price, or nothing
+    STOP,      // Waits for a trade at or through stop_price, then enters as MARKET
+    STOP_LIMIT // Waits for a trade at or through stop_price, then enters as LIMIT
+};
+
+// Incoming order. Price and quantity types follow the book's PriceTraits;
+// Order is the original int form.
+//
+// A resting limit order with display_quantity set is an iceberg: only that
+// much shows at a time, the rest is held in reserve and shown slice by slice.
+// A buy stop triggers on a trade at or above stop_price, a sell stop on one
+// at or below it.
+template <typename Price = int, typename Quantity = int>
+struct BasicOrder {
+    OrderId id;
     Side side;
-    int quantity;
-    int price;
+    Quantity quantity;
+    Price price;
+    OrderType type = OrderType::LIMIT;
+    Quantity display_quantity = 0; // Iceberg peak; 0 shows the whole order
+    Price stop_price = 0;          // Trigger for STOP and STOP_LIMIT
+};
+
+using Order = BasicOrder<>;
+
+// A resting order as for_each_order() lists it and a snapshot stores it: the
+// order, with quantity covering visible and reserve, plus how much of it
+// shows right now. An iceberg part-way through a slice shows less than its
+// display_quantity.
+template <typename Price = int, typename Quantity = int>
+struct BasicRestingOrder : BasicOrder<Price, Quantity> {
+    Quantity visible = 0; // 0 shows a full slice, as add_order() would
 };
 
 inline std::ostream& operator<<(std::ostream& os, Side side) {
@@ -17,7 +53,8 @@ inline std::ostream& operator<<(std::ostream& os, Side side) {
     return os;
 }
 
-inline std::ostream& operator<<(std::ostream& os, const Order& order) {
-    os << order.side << " " << order.quantity << " at " << order.price;
+template <typename Price, typename Quantity>
+std::ostream& operator<<(std::ostream& os, const BasicOrder<Price, Quantity>& order) {
+    os << "#" << order.id << " " << order.side << " " << order.quantity << " at " << order.price;
     return os;
-}
\ No newline at end of file
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Order.h"
+#include <cstdint>
+
+using SymbolId = std::uint32_t;
+
+enum class CommandType : std::uint8_t {
+    ADD, CANCEL, MODIFY, EXECUTE
+};
+
+// Inbound instruction for one symbol's book. Cancel uses only id; modify and
+// execute use id and quantity; order_type, display_quantity and stop_price
+// apply to adds. Every field has a default, so designated initializers only
+// need to name the ones a command uses.
+struct OrderCommand {
+    OrderId id = 0;
+    SymbolId symbol = 0;
+    int quantity = 0;
+    int price = 0;
+    CommandType type = CommandType::ADD;
+    Side side = Side::BUY;
+    OrderType order_type = OrderType::LIMIT;
+    std::uint8_t _padding = 0;
+    int display_quantity = 0;
+    int stop_price = 0;
+};
+
+static_assert(sizeof(OrderCommand) == 32, "OrderCommand should stay compact");
+
+// Applies a command to a book; returns the book's accept/reject result
+template <typename Book>
+bool apply(Book& book, const OrderCommand& command) {
+    switch (command.type) {
+        case CommandType::ADD:
+            return book.add_order({command.id, command.side, command.quantity, command.price,
+                                   command.order_type, command.display_quantity, command.stop_price});
+        case CommandType::CANCEL:
+            return book.cancel_order(command.id);
+        case CommandType::MODIFY:
+            return book.modify_order(command.id, command.quantity);
+        case CommandType::EXECUTE:
+            return book.execute_order(command.id, command.quantity);
+    }
+    return false;
+}
+
+// Applies a command from a venue's order-by-order feed, where matching has
+// already happened: adds rest as given (insert_order) instead of matching,
+// and executes are the trades the venue printed against resting orders
+template <typename Book>
+bool apply_feed(Book& book, const OrderCommand& command) {
+    switch (command.type) {
+        case CommandType::ADD:
+            return book.insert_order({command.id, command.side, command.quantity, command.price,
+                                      command.order_type, command.display_quantity, command.stop_price});
+        case CommandType::CANCEL:
+            return book.cancel_order(command.id);
+        case CommandType::MODIFY:
+            return book.modify_order(command.id, command.quantity);
+        case CommandType::EXECUTE:
+            return book.execute_order(command.id, command.quantity);
+    }
+    return false;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "BookConfig.h"
+#include "LimitOrderBook.h"
+#include "MpscRing.h"
+#include "OrderCommand.h"
+#include "SpscRing.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+using SessionId = std::uint32_t;
+
+// Result of one gateway command, returned to the session that sent it
+struct OrderAck {
+    OrderId id;
+    std::uint64_t tag;  // Echoed from submit(), e.g. a send timestamp
+    CommandType type;
+    bool accepted;
+    std::uint8_t _padding[6];
+};
+
+static_assert(sizeof(OrderAck) == 24, "OrderAck should stay compact");
+
+// Thread-safe front door for one single-threaded book.
+//
+// Any number of session threads submit() into one bounded MPSC ring; the
+// matching thread drain()s it in batches, applies each command to the book
+// and pushes an OrderAck onto the sending session's own SPSC ring, which only
+// that session polls. Nothing blocks and no ack is lost: each session may
+// have at most ack_capacity commands in flight (submitted, ack not yet
+// polled), so its ack always finds room in the ring. A session at that limit
+// or facing a full ingress ring has submit() fail and polls before retrying.
+// A slow session can't stall the matcher or other sessions, and the matching
+// thread never queues acks or allocates on a session's behalf.
+template <typename Book = LimitOrderBook<>>
+class OrderGateway {
+public:
+    OrderGateway(std::size_t num_sessions, const BookConfig& config = {},
+                 std::size_t ingress_capacity = 65536, std::size_t ack_capacity = 65536)
+        : book_(config), ingress_(ingress_capacity)
+    {
+        sessions_.reserve(num_sessions);
+        for (std::size_t s = 0; s < num_sessions; ++s) {
+            sessions_.push_back(std::make_unique<Session>(ack_capacity));
+        }
+    }
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    [[nodiscard]] std::size_t num_sessions() const { return sessions_.size(); }
+
+    // Session threads. Returns false if the session is unknown, already has
+    // a ring's worth of commands in flight (poll acks, then retry) or the
+    // ingress ring is full. The command's symbol field is ignored.
+    bool submit(SessionId session, const OrderCommand& command, std::uint64_t tag = 0) {
+        if (session >= sessions_.size()) return false;
+        Session& owner = *sessions_[session];
+        if (owner.in_flight.fetch_add(1, std::memory_order_relaxed) >= owner.acks.capacity()) {
+            owner.in_flight.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (ingress_.try_push({command, tag, session})) return true;
+        owner.in_flight.fetch_sub(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Owning session thread only. Returns false if no ack is waiting.
+    bool poll_ack(SessionId session, OrderAck& ack) {
+        Session& owner = *sessions_[session];
+        if (!owner.acks.try_pop(ack)) return false;
+        owner.in_flight.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Matching thread only. Applies up to max_batch queued commands and
+    // returns how many it applied.
+    std::size_t drain(std::size_t max_batch = 256) {
+        return ingress_.drain([this](const Message& message) {
+            bool accepted = apply(book_, message.command);
+
+            // Always fits: the session can't have more commands in flight
+            // than its ring holds
+            sessions_[message.session]->acks.try_push(
+                OrderAck{message.command.id, message.tag, message.command.type, accepted, {}});
+        }, max_batch);
+    }
+
+    // Matching thread loop: drains until stop is requested, then empties the ring
+    void run(std::stop_token stop, std::size_t max_batch = 256) {
+        while (!stop.stop_requested()) {
+            if (drain(max_batch) == 0) std::this_thread::yield();
+        }
+        while (drain(max_batch) != 0) {}
+    }
+
+    // Commands this session has submitted whose acks it hasn't polled yet
+    [[nodiscard]] std::uint64_t in_flight(SessionId session) const {
+        return sessions_[session]->in_flight.load(std::memory_order_relaxed);
+    }
+
+    // Direct access; only from the matching thread or while it is stopped
+    [[nodiscard]] Book& book() { return book_; }
+
+private:
+    struct Message {
+        OrderCommand command;
+        std::uint64_t tag;
+        SessionId session;
+    };
+
+    struct Session {
+        explicit Session(std::size_t ack_capacity) : acks(ack_capacity) {}
+
+        SpscRing<OrderAck> acks;
+        alignas(64) std::atomic<std::uint64_t> in_flight{0};  // Session threads only
+    };
+
+    Book book_;
+    MpscRing<Message> ingress_;
+    std::vector<std::unique_ptr<Session>> sessions_;
+};
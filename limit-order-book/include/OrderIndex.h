@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Order.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Open-addressing id -> resting order map, sized up front so inserts and
+// erases never allocate. Linear probing with backward-shift deletion (no
+// tombstones to clog probes under heavy cancel flow); load is kept at or
+// below one half. Going past that doubles the table, which
+// heap_allocations() counts.
+template <typename Node>
+class OrderIndex {
+public:
+    explicit OrderIndex(std::size_t expected_orders) {
+        std::size_t capacity = std::bit_ceil(std::max<std::size_t>(expected_orders * 2, 16));
+        resize(capacity);
+    }
+
+    [[nodiscard]] std::size_t size() const { return size_; }
+    [[nodiscard]] std::size_t heap_allocations() const { return heap_allocations_; }
+
+    [[nodiscard]] Node* find(OrderId id) const {
+        for (std::size_t i = home(id); slots_[i].node; i = (i + 1) & mask_) {
+            if (slots_[i].id == id) return slots_[i].node;
+        }
+        return nullptr;
+    }
+
+    // Pulls id's home slot toward the cache ahead of a find or insert
+    void prefetch(OrderId id) const { __builtin_prefetch(&slots_[home(id)]); }
+
+    // Returns false if id is already present
+    bool insert(OrderId id, Node* node) {
+        if ((size_ + 1) * 2 > slots_.size()) [[unlikely]] grow();
+
+        std::size_t i = home(id);
+        for (; slots_[i].node; i = (i + 1) & mask_) {
+            if (slots_[i].id == id) return false;
+        }
+        slots_[i] = {id, node};
+        ++size_;
+        return true;
+    }
+
+    bool erase(OrderId id) {
+        std::size_t i = home(id);
+        for (; slots_[i].node; i = (i + 1) & mask_) {
+            if (slots_[i].id == id) break;
+        }
+        if (!slots_[i].node) return false;
+
+        // Pull later entries of the probe run back over the hole, unless
+        // their home slot lies cyclically after the hole
+        for (std::size_t j = (i + 1) & mask_; slots_[j].node; j = (j + 1) & mask_) {
+            std::size_t k = home(slots_[j].id);
+            bool stays = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (stays) continue;
+            slots_[i] = slots_[j];
+            i = j;
+        }
+        slots_[i] = {};
+        --size_;
+        return true;
+    }
+
+    // Visits every (id, node) pair in table order
+    template <typename F>
+    void for_each(F&& f) const {
+        for (const Slot& slot : slots_) {
+            if (slot.node) f(slot.id, slot.node);
+        }
+    }
+
+private:
+    struct Slot {
+        OrderId id = 0;
+        Node* node = nullptr; // nullptr marks an empty slot
+    };
+
+    // Fibonacci hashing: sequential ids spread across the table
+    [[nodiscard]] std::size_t home(OrderId id) const {
+        return static_cast<std::size_t>((id * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+    void resize(std::size_t capacity) {
+        slots_.assign(capacity, Slot{});
+        mask_ = capacity - 1;
+        shift_ = 64 - std::countr_zero(capacity);
+    }
+
+    void grow() {
+        std::vector<Slot> old = std::move(slots_);
+        resize(old.size() * 2);
+        ++heap_allocations_;
+
+        for (const Slot& slot : old) {
+            if (!slot.node) continue;
+            std::size_t i = home(slot.id);
+            while (slots_[i].node) i = (i + 1) & mask_;
+            slots_[i] = slot;
+        }
+    }
+
+    std::vector<Slot> slots_;
+    std::size_t mask_ = 0;
+    int shift_ = 64;
+    std::size_t size_ = 0;
+    std::size_t heap_allocations_ = 0;
+};
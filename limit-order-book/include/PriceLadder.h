@@ -0,0 +1,245 @@
+#pragma once
+
+#include "BookConfig.h"
+#include "PriceLevel.h"
+#include "LevelBitmap.h"
+#include "MapLevels.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// One side of the book as a flat array of price levels indexed by tick.
+//
+// Slot for a price is (price / tick_size) mod capacity, with capacity a power
+// of two. Occupied levels always span fewer ticks than the capacity, so the
+// window [low_, low_ + capacity) slides with the market for free: no level
+// ever moves when prices drift. Only when the occupied span itself outgrows
+// the array does it double and re-slot the live levels (re-pointing their
+// orders), which is amortised away for instruments trading within a band.
+//
+// The array never grows past config.max_price_span ticks. A level that would
+// stretch the span further goes into a MapLevels kept beside it instead, so
+// one stray price costs a tree node rather than gigabytes of slots. While
+// that map is empty every operation takes the array-only path.
+//
+// A LevelBitmap over the slots finds the next occupied level when an end of
+// the range empties, so sweeping a sparse book never scans empty slots.
+//
+// The tick size is a compile-time PriceTraits constant, so price -> slot is
+// a constant division and a mask.
+template <Side S, typename Traits = IntPrices>
+class PriceLadder {
+public:
+    using Price = typename Traits::Price;
+    using Level = BasicPriceLevel<Traits>;
+
+    PriceLadder() : PriceLadder(BookConfig{}) {}
+
+    explicit PriceLadder(const BookConfig& config)
+        : slots_(round_up_pow2(config.initial_levels)),
+          occupied_(slots_.size()),
+          mask_(slots_.size() - 1),
+          max_span_(std::max(slots_.size(), config.max_price_span)),
+          far_(BookConfig{.initial_levels = far_initial_levels}) {}
+
+    [[nodiscard]] bool empty() const { return count_ == 0 && far_.empty(); }
+    [[nodiscard]] std::size_t capacity() const { return slots_.size(); }
+    [[nodiscard]] std::size_t heap_allocations() const { return grow_count_ + far_.heap_allocations(); }
+
+    // Levels kept in the map because they lie beyond max_price_span
+    [[nodiscard]] std::size_t far_levels() const {
+        std::size_t n = 0;
+        far_.for_each([&n](const Level&) { ++n; });
+        return n;
+    }
+
+    [[nodiscard]] Level* best() {
+        return const_cast<Level*>(std::as_const(*this).best());
+    }
+    [[nodiscard]] const Level* best() const {
+        const Level* near = count_ ? &slot(best_tick()) : nullptr;
+        if (far_.empty()) [[likely]] return near;
+        return better_of(near, far_.best());
+    }
+
+    [[nodiscard]] const Level* find(Price price) const {
+        Price tick = Traits::to_tick(price);
+        if (count_ != 0 && tick >= low_ && tick <= high_) {
+            const Level& level = slot(tick);
+            if (!level.empty()) return &level;
+        }
+        return far_.empty() ? nullptr : far_.find(price);
+    }
+
+    // Best level strictly worse than price, or nullptr. price itself need not
+    // be occupied.
+    [[nodiscard]] const Level* next_worse(Price price) const {
+        const Level* near = near_next_worse(Traits::to_tick(price));
+        if (far_.empty()) [[likely]] return near;
+        return better_of(near, far_.next_worse(price));
+    }
+
+    // Pulls the slot for price toward the cache; any price is safe
+    void prefetch(Price price) const { __builtin_prefetch(&slot(Traits::to_tick(price))); }
+
+    // Existing level at price, or a new empty one. The caller queues an order
+    // on a new level before touching the ladder again.
+    Level& level_for(Price price) {
+        Price tick = Traits::to_tick(price);
+        if (!far_.empty() && far_.find(price)) [[unlikely]] return far_.level_for(price);
+        if (count_ == 0) {
+            low_ = high_ = tick;
+        }
+        else {
+            Price low = std::min(low_, tick);
+            Price high = std::max(high_, tick);
+            std::size_t span = static_cast<std::size_t>(high - low) + 1;
+            if (span > slots_.size()) {
+                if (span > max_span_) [[unlikely]] return far_.level_for(price);
+                grow(span);
+            }
+            low_ = low;
+            high_ = high;
+        }
+
+        Level& level = slot(tick);
+        if (level.empty()) {
+            level = Level(price);
+            occupied_.set(index(tick));
+            ++count_;
+        }
+        return level;
+    }
+
+    // Drops an emptied level, tightening the occupied range if it was an end
+    void erase(Level& level) {
+        if (!far_.empty() && !in_slots(level)) [[unlikely]] {
+            far_.erase(level);
+            return;
+        }
+        Price tick = Traits::to_tick(level.price());
+        occupied_.clear(index(tick));
+        if (--count_ == 0) return;
+
+        if (tick == low_) low_ = next_occupied(tick);
+        else if (tick == high_) high_ = prev_occupied(tick);
+    }
+
+    // Visits levels best to worst
+    template <typename F>
+    void for_each(F&& f) const {
+        if (!far_.empty()) [[unlikely]] {
+            for (const Level* level = best(); level; level = next_worse(level->price())) f(*level);
+            return;
+        }
+        if (count_ == 0) return;
+        if constexpr (S == Side::BUY) {
+            for (Price tick = high_; ; tick = prev_occupied(tick)) {
+                f(slot(tick));
+                if (tick == low_) break;
+            }
+        }
+        else {
+            for (Price tick = low_; ; tick = next_occupied(tick)) {
+                f(slot(tick));
+                if (tick == high_) break;
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t far_initial_levels = 64;
+
+    static std::size_t round_up_pow2(std::size_t n) {
+        std::size_t size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    [[nodiscard]] Price best_tick() const {
+        if constexpr (S == Side::BUY) return high_;
+        else return low_;
+    }
+
+    // Whichever of two levels (either may be null) is closer to the front
+    [[nodiscard]] static const Level* better_of(const Level* a, const Level* b) {
+        if (!a) return b;
+        if (!b) return a;
+        if constexpr (S == Side::BUY) return b->price() > a->price() ? b : a;
+        else return b->price() < a->price() ? b : a;
+    }
+
+    [[nodiscard]] bool in_slots(const Level& level) const {
+        std::less<const Level*> before;
+        return !before(&level, slots_.data()) && before(&level, slots_.data() + slots_.size());
+    }
+
+    // next_worse() over the array alone
+    [[nodiscard]] const Level* near_next_worse(Price tick) const {
+        if (count_ == 0) return nullptr;
+        if constexpr (S == Side::BUY) {
+            if (tick <= low_) return nullptr;
+            return &slot(tick > high_ ? high_ : prev_occupied(tick));
+        }
+        else {
+            if (tick >= high_) return nullptr;
+            return &slot(tick < low_ ? low_ : next_occupied(tick));
+        }
+    }
+
+    [[nodiscard]] std::size_t index(Price tick) const { return static_cast<std::size_t>(tick) & mask_; }
+
+    Level& slot(Price tick) { return slots_[index(tick)]; }
+    const Level& slot(Price tick) const { return slots_[index(tick)]; }
+
+    // Nearest occupied tick above/below tick. Occupied ticks span less than
+    // the capacity, so the first set slot in ring order is the right one.
+    [[nodiscard]] Price next_occupied(Price tick) const {
+        std::size_t from = index(tick);
+        std::size_t found = occupied_.find_next(from + 1);
+        if (found == LevelBitmap::npos) found = occupied_.find_next(0);
+        return tick + static_cast<Price>((found - from) & mask_);
+    }
+
+    [[nodiscard]] Price prev_occupied(Price tick) const {
+        std::size_t from = index(tick);
+        std::size_t found = from == 0 ? LevelBitmap::npos : occupied_.find_prev(from - 1);
+        if (found == LevelBitmap::npos) found = occupied_.find_prev(mask_);
+        return tick - static_cast<Price>((from - found) & mask_);
+    }
+
+    // Doubles until span ticks fit, re-slotting every live level
+    void grow(std::size_t span) {
+        std::size_t size = slots_.size();
+        while (size < span) size <<= 1;
+
+        std::vector<Level> slots(size);
+        LevelBitmap occupied(size);
+        std::size_t mask = size - 1;
+        for (Price tick = low_; ; tick = next_occupied(tick)) {
+            std::size_t i = static_cast<std::size_t>(tick) & mask;
+            slots[i] = slot(tick);
+            slots[i].rebind();
+            occupied.set(i);
+            if (tick == high_) break;
+        }
+
+        slots_.swap(slots);
+        occupied_ = std::move(occupied);
+        mask_ = mask;
+        ++grow_count_;
+    }
+
+    std::vector<Level> slots_;
+    LevelBitmap occupied_;
+    std::size_t mask_;
+    std::size_t max_span_;  // Most ticks the array may cover
+
+    std::size_t count_ = 0; // Non-empty levels in the array
+    Price low_ = 0;         // Lowest occupied tick (valid when count_ > 0)
+    Price high_ = 0;        // Highest occupied tick
+    std::size_t grow_count_ = 0;
+    MapLevels<S, Traits> far_; // Levels past max_span_ from the array's range
+};
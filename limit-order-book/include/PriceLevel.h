@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Order.h"
+#include "PriceTraits.h"
+#include <cstddef>
+#include <utility>
+
+template <typename Traits>
+class BasicPriceLevel;
+
+// Resting order. Links into its level's FIFO queue directly (intrusive list),
+// so unlinking on cancel or fill never walks the level. quantity is what
+// shows; an iceberg also holds reserve, released peak at a time. A pending
+// stop is queued the same way on its trigger level, with type saying what it
+// becomes.
+template <typename Traits>
+struct BasicOrderNode {
+    OrderId id;
+    Side side;
+    typename Traits::Price price;
+    typename Traits::Quantity quantity;
+    typename Traits::Quantity reserve = 0;
+    typename Traits::Quantity peak = 0;
+    OrderType type = OrderType::LIMIT;
+
+    BasicOrderNode* prev = nullptr;
+    BasicOrderNode* next = nullptr;
+    BasicPriceLevel<Traits>* level = nullptr;
+};
+
+// All resting orders at one price, in time priority (head is oldest).
+template <typename Traits>
+class BasicPriceLevel {
+public:
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+    using Node = BasicOrderNode<Traits>;
+
+    BasicPriceLevel() = default;
+    explicit BasicPriceLevel(Price price) : price_(price) {}
+
+    [[nodiscard]] Price price() const { return price_; }
+    [[nodiscard]] Quantity total_quantity() const { return total_quantity_; }
+    [[nodiscard]] Quantity reserve_quantity() const { return reserve_quantity_; }
+    [[nodiscard]] std::size_t order_count() const { return order_count_; }
+    [[nodiscard]] bool empty() const { return head_ == nullptr; }
+
+    [[nodiscard]] Node* front() const { return head_; }
+
+    // Appends at the tail: newest order, lowest priority
+    void push_back(Node* node) {
+        node->level = this;
+        node->prev = tail_;
+        node->next = nullptr;
+        if (tail_) tail_->next = node;
+        else head_ = node;
+        tail_ = node;
+
+        total_quantity_ += node->quantity;
+        reserve_quantity_ += node->reserve;
+        ++order_count_;
+    }
+
+    // Unlinks node from anywhere in the queue in O(1)
+    void remove(Node* node) {
+        if (node->prev) node->prev->next = node->next;
+        else head_ = node->next;
+        if (node->next) node->next->prev = node->prev;
+        else tail_ = node->prev;
+
+        total_quantity_ -= node->quantity;
+        reserve_quantity_ -= node->reserve;
+        --order_count_;
+        node->prev = node->next = nullptr;
+    }
+
+    // Shrinks a resting order in place; keeps its queue position
+    void reduce(Node* node, Quantity quantity) {
+        node->quantity -= quantity;
+        total_quantity_ -= quantity;
+    }
+
+    // Shrinks an iceberg's hidden reserve; the visible slice is untouched
+    void reduce_reserve(Node* node, Quantity quantity) {
+        node->reserve -= quantity;
+        reserve_quantity_ -= quantity;
+    }
+
+    // Shows an iceberg's next slice once the visible one is used up. The new
+    // slice joins the back of the queue, as a fresh order would.
+    void refresh(Node* node) {
+        remove(node);
+        node->quantity = node->peak < node->reserve ? node->peak : node->reserve;
+        node->reserve -= node->quantity;
+        push_back(node);
+    }
+
+    // Empties the level in O(1), handing back its queue oldest first as a
+    // chain linked through next (the tail is second)
+    std::pair<Node*, Node*> release() {
+        std::pair<Node*, Node*> chain{head_, tail_};
+        head_ = tail_ = nullptr;
+        total_quantity_ = reserve_quantity_ = 0;
+        order_count_ = 0;
+        return chain;
+    }
+
+    // Re-points every queued order at this level after the level object moved
+    void rebind() {
+        for (Node* node = head_; node; node = node->next) node->level = this;
+    }
+
+private:
+    Price price_ = 0;
+    Quantity total_quantity_ = 0;   // Visible
+    Quantity reserve_quantity_ = 0; // Hidden behind icebergs
+    std::size_t order_count_ = 0;
+    Node* head_ = nullptr;
+    Node* tail_ = nullptr;
+};
+
+using OrderNode = BasicOrderNode<IntPrices>;
+using PriceLevel = BasicPriceLevel<IntPrices>;
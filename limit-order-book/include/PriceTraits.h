@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+// Price and quantity representation for a book.
+//
+// Prices are fixed-point integers counting 1/Scale units of the currency
+// (Scale = 100 makes 12345 mean 123.45) and must be multiples of TickSize.
+// Both are compile-time constants, so tick arithmetic on the hot path is
+// division by a constant, which compiles to a shift or a multiply.
+template <typename P, typename Q, P TickSize = 1, P Scale = 1>
+struct PriceTraits {
+    static_assert(std::is_integral_v<P> && std::is_signed_v<P>, "prices are signed fixed-point integers");
+    static_assert(std::is_integral_v<Q> && std::is_signed_v<Q>, "quantities are signed integers");
+    static_assert(TickSize > 0 && Scale > 0);
+
+    using Price = P;
+    using Quantity = Q;
+
+    static constexpr Price tick_size = TickSize;
+    static constexpr Price scale = Scale;
+
+    [[nodiscard]] static constexpr Price to_tick(Price price) { return price / tick_size; }
+    [[nodiscard]] static constexpr bool on_tick(Price price) { return price % tick_size == 0; }
+
+    [[nodiscard]] static constexpr double to_double(Price price) { return static_cast<double>(price) / scale; }
+    [[nodiscard]] static Price from_double(double price) { return static_cast<Price>(std::llround(price * scale)); }
+};
+
+// The original representation: int prices in ticks of 1
+using IntPrices = PriceTraits<int, int>;
+
+// 64-bit prices and quantities for real notional values
+using WidePrices = PriceTraits<std::int64_t, std::int64_t>;
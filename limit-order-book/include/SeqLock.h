@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Single-writer sequence lock for small trivially copyable values.
+//
+// The writer bumps the sequence to odd, stores the value, then bumps it back
+// to even; it never waits for readers. A reader copies the value between two
+// sequence loads and keeps it only if both saw the same even number. The
+// payload is held as relaxed atomic words, so a torn copy is discarded rather
+// than being a data race. try_load() is a single bounded attempt (wait-free);
+// load() retries and only spins while a store is in flight.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock copies the value bytewise");
+
+public:
+    SeqLock() { store_words(T{}); }
+
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+
+    // Writer only
+    void store(const T& value) {
+        std::uint64_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        store_words(value);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    // Returns false if a store overlapped the copy; out is then unspecified
+    bool try_load(T& out) const {
+        std::uint64_t before = seq_.load(std::memory_order_acquire);
+        if (before & 1) return false;
+        load_words(out);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return seq_.load(std::memory_order_relaxed) == before;
+    }
+
+    [[nodiscard]] T load() const {
+        T value;
+        while (!try_load(value)) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        return value;
+    }
+
+    // Number of completed stores
+    [[nodiscard]] std::uint64_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    void store_words(const T& value) {
+        std::uint64_t words[WORDS] = {};
+        std::memcpy(words, &value, sizeof(T));
+        for (std::size_t i = 0; i < WORDS; ++i) words_[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    void load_words(T& value) const {
+        std::uint64_t words[WORDS];
+        for (std::size_t i = 0; i < WORDS; ++i) words[i] = words_[i].load(std::memory_order_relaxed);
+        std::memcpy(&value, words, sizeof(T));
+    }
+
+    // Sequence and payload share one line, away from the writer's other state
+    alignas(64) std::atomic<std::uint64_t> seq_{0};
+    std::atomic<std::uint64_t> words_[WORDS];
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Fixed-size block allocator.
+//
+// Blocks are carved from slabs allocated up front; freed blocks go on an
+// intrusive free list and are handed out again LIFO, while still warm in
+// cache. Running dry adds another slab. heap_allocations() counts every trip
+// to the heap after construction, so a steady-state workload that stays at
+// zero provably never called operator new.
+class SlabPool {
+public:
+    SlabPool(std::size_t block_size, std::size_t block_align, std::size_t blocks_per_slab);
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    [[nodiscard]] void* allocate() {
+        if (!free_) [[unlikely]] add_slab();
+        FreeBlock* block = free_;
+        free_ = block->next;
+        ++in_use_;
+        return block;
+    }
+
+    void deallocate(void* p) {
+        auto* block = static_cast<FreeBlock*>(p);
+        block->next = free_;
+        free_ = block;
+        --in_use_;
+    }
+
+    // Requests the pool can't serve from a block (arrays, oversized types)
+    [[nodiscard]] void* allocate_oversize(std::size_t bytes, std::size_t align);
+    void deallocate_oversize(void* p, std::size_t align);
+
+    [[nodiscard]] std::size_t block_size() const { return block_size_; }
+    [[nodiscard]] std::size_t block_align() const { return block_align_; }
+    [[nodiscard]] std::size_t in_use() const { return in_use_; }
+    [[nodiscard]] std::size_t capacity() const { return slabs_.size() * blocks_per_slab_; }
+    [[nodiscard]] std::size_t heap_allocations() const { return heap_allocations_; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct SlabDeleter {
+        std::size_t align;
+        void operator()(std::byte* p) const { ::operator delete(p, std::align_val_t{align}); }
+    };
+
+    void add_slab();
+
+    std::size_t block_size_;
+    std::size_t block_align_;
+    std::size_t blocks_per_slab_;
+
+    std::vector<std::unique_ptr<std::byte, SlabDeleter>> slabs_;
+    FreeBlock* free_ = nullptr;
+    std::size_t in_use_ = 0;
+    std::size_t heap_allocations_ = 0;
+};
+
+// Typed front end over a SlabPool: placement-constructs T into pool blocks.
+// Live objects are not destroyed with the pool, hence the trivial-destructor
+// requirement.
+template <typename T>
+class ObjectPool {
+    static_assert(std::is_trivially_destructible_v<T>, "ObjectPool never runs destructors of live objects");
+
+public:
+    explicit ObjectPool(std::size_t capacity) : pool_(sizeof(T), alignof(T), capacity) {}
+
+    template <typename... Args>
+    [[nodiscard]] T* create(Args&&... args) {
+        return new (pool_.allocate()) T{std::forward<Args>(args)...};
+    }
+
+    void destroy(T* object) { pool_.deallocate(object); }
+
+    [[nodiscard]] std::size_t in_use() const { return pool_.in_use(); }
+    [[nodiscard]] std::size_t capacity() const { return pool_.capacity(); }
+    [[nodiscard]] std::size_t heap_allocations() const { return pool_.heap_allocations(); }
+
+private:
+    SlabPool pool_;
+};
+
+// Standard allocator drawing single objects from a SlabPool, for node-based
+// containers. Any allocation the pool's block can't hold falls back to the
+// heap and is counted by the pool.
+template <typename T>
+class SlabAllocator {
+public:
+    using value_type = T;
+
+    explicit SlabAllocator(SlabPool& pool) : pool_(&pool) {}
+
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U>& other) : pool_(other.pool()) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (fits(n)) return static_cast<T*>(pool_->allocate());
+        return static_cast<T*>(pool_->allocate_oversize(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (fits(n)) pool_->deallocate(p);
+        else pool_->deallocate_oversize(p, alignof(T));
+    }
+
+    [[nodiscard]] SlabPool* pool() const { return pool_; }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U>& other) const { return pool_ == other.pool(); }
+    template <typename U>
+    bool operator!=(const SlabAllocator<U>& other) const { return pool_ != other.pool(); }
+
+private:
+    [[nodiscard]] bool fits(std::size_t n) const {
+        return n == 1 && sizeof(T) <= pool_->block_size() && alignof(T) <= pool_->block_align();
+    }
+
+    SlabPool* pool_;
+};
+
+// Size and alignment of the single objects a container asks its allocator
+// for. For node-based containers that is the library's node type, which
+// allocate() is rebound to but which can't be named portably.
+struct BlockLayout {
+    std::size_t size = 0;
+    std::size_t align = 0;
+};
+
+// Standard allocator that records the largest single-object request in a
+// BlockLayout and forwards to the heap. Insert one value into a throwaway
+// container built with it to learn how big to make its SlabPool blocks.
+template <typename T>
+class LayoutProbe {
+public:
+    using value_type = T;
+
+    explicit LayoutProbe(BlockLayout& layout) : layout_(&layout) {}
+
+    template <typename U>
+    LayoutProbe(const LayoutProbe<U>& other) : layout_(other.layout()) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        if (n == 1) {
+            layout_->size = std::max(layout_->size, sizeof(T));
+            layout_->align = std::max(layout_->align, alignof(T));
+        }
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) { std::allocator<T>{}.deallocate(p, n); }
+
+    [[nodiscard]] BlockLayout* layout() const { return layout_; }
+
+    template <typename U>
+    bool operator==(const LayoutProbe<U>& other) const { return layout_ == other.layout(); }
+    template <typename U>
+    bool operator!=(const LayoutProbe<U>& other) const { return layout_ != other.layout(); }
+
+private:
+    BlockLayout* layout_;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Binary image of every resting order in a book.
+//
+// A 48-byte header followed by `count` records, each laid out as the book's
+// RestingOrder type (the order plus the slice it shows), bids then asks,
+// best level first and in queue order within a level, then pending stops.
+// Restoring the records in file order (restore_orders) to an empty book
+// rebuilds it exactly, iceberg slices included. The header names the journal
+// generation the snapshot continues into and how many of its records it
+// already reflects.
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_size;
+    std::uint64_t count;
+    std::uint64_t generation;
+    std::uint64_t journal_count;
+    std::uint64_t _reserved;
+};
+
+static_assert(sizeof(SnapshotHeader) == 48, "Header must keep records 8-byte aligned");
+
+inline constexpr char SNAPSHOT_MAGIC[8] = {'L', 'O', 'B', 'S', 'N', 'A', 'P', '\0'};
+inline constexpr std::uint32_t SNAPSHOT_VERSION = 2;
+
+// Writes a snapshot to path + ".tmp" and renames it over path on commit(),
+// so a crash mid-write leaves the previous snapshot intact. Throws
+// std::runtime_error on I/O failure.
+class SnapshotWriter {
+public:
+    SnapshotWriter(const std::string& path, std::uint32_t record_size,
+                   std::uint64_t generation, std::uint64_t journal_count);
+    ~SnapshotWriter();
+
+    SnapshotWriter(const SnapshotWriter&) = delete;
+    SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+    void write(const void* records, std::size_t count);
+
+    // Syncs the file to disk and atomically replaces path
+    void commit();
+
+private:
+    void drain();
+
+    std::string path_;
+    std::string tmp_path_;
+    int fd_ = -1;
+    SnapshotHeader header_;
+    std::vector<std::byte> buffer_;
+};
+
+// Read-only memory mapping of a snapshot. Throws std::runtime_error if the
+// file can't be mapped, isn't a snapshot, or holds records of another size.
+class MappedSnapshot {
+public:
+    MappedSnapshot(const std::string& path, std::uint32_t record_size);
+    ~MappedSnapshot();
+
+    MappedSnapshot(const MappedSnapshot&) = delete;
+    MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+    [[nodiscard]] const SnapshotHeader& header() const { return *static_cast<const SnapshotHeader*>(data_); }
+    [[nodiscard]] const void* records() const { return static_cast<const std::byte*>(data_) + sizeof(SnapshotHeader); }
+
+private:
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Header of the snapshot at path, or nullopt if there is no valid one
+std::optional<SnapshotHeader> read_snapshot_header(const std::string& path);
+
+// Writes every resting order in book, in for_each_order() sequence, to path
+template <typename Book>
+void write_snapshot(const Book& book, const std::string& path,
+                    std::uint64_t generation = 0, std::uint64_t journal_count = 0) {
+    using Record = typename Book::RestingOrder;
+    SnapshotWriter writer(path, sizeof(Record), generation, journal_count);
+    std::array<Record, 1024> chunk;
+    std::size_t n = 0;
+    book.for_each_order([&](const Record& order) {
+        chunk[n++] = order;
+        if (n == chunk.size()) {
+            writer.write(chunk.data(), n);
+            n = 0;
+        }
+    });
+    writer.write(chunk.data(), n);
+    writer.commit();
+}
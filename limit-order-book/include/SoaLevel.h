@@ -0,0 +1,152 @@
+#pragma once
+
+#include "Order.h"
+#include "PriceTraits.h"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// All resting orders at one price as parallel arrays of ids and quantities
+// (struct of arrays), oldest first from head_. A standalone queue layout for
+// measuring deep sweeps against the intrusive node list in BasicPriceLevel
+// (BM_SweepSoaLevel); it is not a level store LimitOrderBook can use, since
+// the book's order index, icebergs and level moves all hold OrderNode
+// pointers.
+//
+// Fills consume from the front by advancing head_; a cancel erases in place
+// and shifts the younger orders down, so the live orders stay contiguous and
+// a sweep reads two sequential arrays instead of chasing a pointer per order.
+// fill() locates the last order it reaches with a running prefix sum over
+// the quantities, four lanes at a time with SSE2 when Quantity is 32-bit.
+// The consumed prefix is reclaimed when a push would otherwise grow the
+// arrays. Cancel and position lookups are O(orders in the level).
+template <typename Traits>
+class BasicSoaLevel {
+public:
+    using Price = typename Traits::Price;
+    using Quantity = typename Traits::Quantity;
+
+    explicit BasicSoaLevel(Price price = 0, std::size_t capacity = 64) : price_(price) {
+        ids_.reserve(capacity);
+        quantities_.reserve(capacity);
+    }
+
+    [[nodiscard]] Price price() const { return price_; }
+    [[nodiscard]] Quantity total_quantity() const { return total_quantity_; }
+    [[nodiscard]] std::size_t order_count() const { return ids_.size() - head_; }
+    [[nodiscard]] bool empty() const { return head_ == ids_.size(); }
+
+    // Live orders, oldest first
+    [[nodiscard]] std::span<const OrderId> ids() const { return std::span(ids_).subspan(head_); }
+    [[nodiscard]] std::span<const Quantity> quantities() const { return std::span(quantities_).subspan(head_); }
+
+    // Appends at the tail: newest order, lowest priority
+    void push_back(OrderId id, Quantity quantity) {
+        if (ids_.size() == ids_.capacity() && head_ > 0) compact();
+        ids_.push_back(id);
+        quantities_.push_back(quantity);
+        total_quantity_ += quantity;
+    }
+
+    // Erases id wherever it is queued, keeping everyone else's order.
+    // Returns false if it isn't at this level.
+    bool remove(OrderId id) {
+        auto it = std::find(ids_.begin() + static_cast<std::ptrdiff_t>(head_), ids_.end(), id);
+        if (it == ids_.end()) return false;
+        auto i = it - ids_.begin();
+        total_quantity_ -= quantities_[i];
+        ids_.erase(it);
+        quantities_.erase(quantities_.begin() + i);
+        if (empty()) clear();
+        return true;
+    }
+
+    // Trades up to quantity against the queue, oldest first, calling
+    // on_fill(id, traded, leaves) for every order reached. Returns the
+    // quantity traded.
+    template <typename OnFill>
+    Quantity fill(Quantity quantity, OnFill&& on_fill) {
+        if (quantity <= 0 || empty()) return 0;
+        Quantity traded = std::min(quantity, total_quantity_);
+        auto [last, before] = reach(traded);
+
+        // Orders up to last are used up; last keeps whatever traded doesn't take
+        for (std::size_t i = head_; i < last; ++i) on_fill(ids_[i], quantities_[i], Quantity{0});
+        Quantity taken = traded - before;
+        quantities_[last] -= taken;
+        on_fill(ids_[last], taken, quantities_[last]);
+
+        head_ = quantities_[last] == 0 ? last + 1 : last;
+        total_quantity_ -= traded;
+        if (empty()) clear();
+        return traded;
+    }
+
+private:
+    // First order at which the running sum from head_ reaches target (which
+    // must not exceed total_quantity_), and the sum before it. No partial
+    // sum exceeds the level's total, so the 32-bit lanes can't overflow.
+    std::pair<std::size_t, Quantity> reach(Quantity target) const {
+        const Quantity* q = quantities_.data();
+        std::size_t i = head_;
+        std::size_t end = quantities_.size();
+        Quantity sum = 0;
+
+#if defined(__SSE2__)
+        if constexpr (sizeof(Quantity) == 4 && std::is_signed_v<Quantity>) {
+            __m128i carry = _mm_setzero_si128();
+            __m128i below = _mm_set1_epi32(target - 1);
+            for (; i + 4 <= end; i += 4) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + i));
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+                x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+                x = _mm_add_epi32(x, carry);
+                int hits = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(x, below)));
+                if (hits) {
+                    alignas(16) std::int32_t lanes[4];
+                    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), x);
+                    std::size_t lane = static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(hits)));
+                    return {i + lane, lanes[lane] - q[i + lane]};
+                }
+                carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+            }
+            sum = _mm_cvtsi128_si32(carry);
+        }
+#endif
+        for (; i < end; ++i) {
+            if (sum + q[i] >= target) return {i, sum};
+            sum += q[i];
+        }
+        return {end - 1, sum - q[end - 1]};
+    }
+
+    // Moves the live orders back to the front of the arrays
+    void compact() {
+        ids_.erase(ids_.begin(), ids_.begin() + static_cast<std::ptrdiff_t>(head_));
+        quantities_.erase(quantities_.begin(), quantities_.begin() + static_cast<std::ptrdiff_t>(head_));
+        head_ = 0;
+    }
+
+    void clear() {
+        ids_.clear();
+        quantities_.clear();
+        head_ = 0;
+    }
+
+    Price price_;
+    Quantity total_quantity_ = 0;
+    std::size_t head_ = 0;          // First live order
+    std::vector<OrderId> ids_;
+    std::vector<Quantity> quantities_;
+};
+
+using SoaLevel = BasicSoaLevel<IntPrices>;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Single-producer, single-consumer lock-free ring.
+//
+// Capacity is a power of two and head/tail are free-running counters, so a
+// slot is counter & mask and every slot is usable. Each side keeps a cached
+// copy of the other side's counter and only reloads it (acquire) when the
+// cache says full/empty, so the common path touches no shared cache line.
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity)
+        : buffer_(round_up_pow2(capacity)), mask_(buffer_.size() - 1) {}
+
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    [[nodiscard]] std::size_t capacity() const { return buffer_.size(); }
+
+    // Producer: returns false if full, never blocks
+    bool try_push(const T& item) {
+        std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cached_tail_ == buffer_.size()) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head - cached_tail_ == buffer_.size()) return false;
+        }
+        buffer_[head & mask_] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: returns false if empty
+    bool try_pop(T& out) {
+        std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail == cached_head_) return false;
+        }
+        out = buffer_[tail & mask_];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static std::size_t round_up_pow2(std::size_t n) {
+        std::size_t size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    std::vector<T> buffer_;
+    std::size_t mask_;
+
+    // Producer line: its counter plus its view of the consumer
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_ = 0;
+
+    // Consumer line
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_ = 0;
+};
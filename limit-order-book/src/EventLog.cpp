@@ -0,0 +1,134 @@
+#include "EventLog.h"
+#include <stdexcept>
+
+namespace {
+
+std::uint64_t steady_ns() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+// A log_clock() reading paired with steady_clock at the same instant: the
+// counter is taken midway between reads on either side of the clock call
+void sample_clocks(std::uint64_t& ticks, std::uint64_t& ns) {
+    std::uint64_t before = log_clock();
+    ns = steady_ns();
+    std::uint64_t after = log_clock();
+    ticks = before + (after - before) / 2;
+}
+
+constexpr std::uint64_t MIN_CALIBRATION_NS = 1'000'000;
+
+}
+
+bool LogChannel::on_full(const LogRecord& record) {
+    if (overflow_ == LogOverflow::DROP) {
+        ++dropped_;
+        return false;
+    }
+    ++stalls_;
+    do {
+        owner_->wake();
+        std::this_thread::yield();
+    } while (!ring_.try_push(record));
+    return true;
+}
+
+EventLog::EventLog(const std::string& path, std::size_t ring_capacity, std::chrono::milliseconds poll_interval)
+    : out_(path, std::ios::trunc), ring_capacity_(ring_capacity), poll_interval_(poll_interval)
+{
+    if (!out_) throw std::runtime_error("Failed to open file: " + path);
+
+    // First rate estimate before anything is formatted; every drain pass
+    // refines it over the longer span since construction
+    sample_clocks(anchor_ticks_, anchor_ns_);
+    std::uint64_t ticks = 0;
+    std::uint64_t ns = 0;
+    do {
+        sample_clocks(ticks, ns);
+    } while (ns - anchor_ns_ < MIN_CALIBRATION_NS);
+    ns_per_tick_ = static_cast<double>(ns - anchor_ns_) / static_cast<double>(ticks - anchor_ticks_);
+
+    drainer_ = std::jthread([this](std::stop_token stop) { drain_loop(stop); });
+}
+
+EventLog::~EventLog() {
+    drainer_.request_stop();
+    if (drainer_.joinable()) drainer_.join();
+}
+
+LogChannel& EventLog::channel(LogOverflow overflow) {
+    std::lock_guard lock(channels_mutex_);
+    channels_.push_back(std::make_unique<LogChannel>(ring_capacity_, *this, overflow));
+    return *channels_.back();
+}
+
+void EventLog::wake() {
+    wake_requested_.store(true, std::memory_order_release);
+    wake_.notify_one();
+}
+
+void EventLog::flush() {
+    drain();
+    std::lock_guard lock(channels_mutex_);
+    out_.flush();
+}
+
+void EventLog::drain_loop(std::stop_token stop) {
+    std::mutex mutex;
+    std::unique_lock lock(mutex);
+    while (!stop.stop_requested()) {
+        drain();
+        // A wake that lands between the check and the wait is missed, but a
+        // blocked channel keeps calling wake() until it gets room
+        wake_.wait_for(lock, stop, poll_interval_,
+                       [this] { return wake_requested_.exchange(false, std::memory_order_acquire); });
+    }
+    drain();
+    out_.flush();
+}
+
+void EventLog::drain() {
+    std::lock_guard lock(channels_mutex_);
+    calibrate();
+    LogRecord record;
+    for (std::size_t c = 0; c < channels_.size(); ++c) {
+        while (channels_[c]->ring_.try_pop(record)) {
+            format(c, record);
+            written_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void EventLog::calibrate() {
+    std::uint64_t ticks = 0;
+    std::uint64_t ns = 0;
+    sample_clocks(ticks, ns);
+    if (ns - anchor_ns_ >= MIN_CALIBRATION_NS && ticks > anchor_ticks_) {
+        ns_per_tick_ = static_cast<double>(ns - anchor_ns_) / static_cast<double>(ticks - anchor_ticks_);
+    }
+}
+
+void EventLog::format(std::size_t channel, const LogRecord& record) {
+    auto elapsed = static_cast<double>(static_cast<std::int64_t>(record.timestamp - anchor_ticks_));
+    out_ << static_cast<std::int64_t>(anchor_ns_) + static_cast<std::int64_t>(elapsed * ns_per_tick_) << " [" << channel << "] ";
+    switch (record.kind) {
+        case LogKind::REPORT:
+            out_ << record.report;
+            break;
+        case LogKind::BOOK_BEGIN:
+            out_ << "--- ORDER BOOK (seq " << record.sequence << ") ---";
+            break;
+        case LogKind::BOOK_LEVEL:
+            out_ << (record.side == Side::BUY ? "BID " : "ASK ") << record.level.price << ": "
+                 << record.level.quantity << " (" << record.level.order_count << " orders)";
+            break;
+        case LogKind::BOOK_END:
+            out_ << "---------------------";
+            break;
+        case LogKind::MARK:
+            out_ << record.text;
+            break;
+    }
+    out_ << '\n';
+}
@@ -0,0 +1,71 @@
+#include "FlowGenerator.h"
+#include <algorithm>
+
+FlowGenerator::FlowGenerator(const FlowConfig& config)
+    : config_(config),
+      rng_(config.seed),
+      symbols_(config.num_symbols, SymbolState{config.mid_price, {}})
+{
+    for (auto& state : symbols_) state.live.reserve(4096);
+}
+
+OrderCommand FlowGenerator::next() {
+    SymbolId symbol = static_cast<SymbolId>(rng_() % symbols_.size());
+    SymbolState& state = symbols_[symbol];
+
+    double roll = unit_(rng_);
+    if (state.live.empty() || roll < config_.add_ratio) return make_add(symbol, state);
+
+    OrderCommand command{};
+    command.symbol = symbol;
+    roll -= config_.add_ratio;
+    if (roll < config_.cancel_ratio) {
+        command.type = CommandType::CANCEL;
+        command.id = take_live(state, true);
+    }
+    else if (roll < config_.cancel_ratio + config_.modify_ratio) {
+        command.type = CommandType::MODIFY;
+        command.id = take_live(state, false);
+        command.quantity = quantity_(rng_);
+    }
+    else {
+        command.type = CommandType::EXECUTE;
+        command.id = take_live(state, false);
+        command.quantity = quantity_(rng_) / 4 + 1;
+    }
+    return command;
+}
+
+OrderCommand FlowGenerator::make_add(SymbolId symbol, SymbolState& state) {
+    // Slow random walk of the mid
+    if (unit_(rng_) < 0.01) state.mid += (rng_() & 1) ? 1 : -1;
+
+    OrderCommand command{};
+    command.type = CommandType::ADD;
+    command.symbol = symbol;
+    command.id = next_id_++;
+    command.side = (rng_() & 1) ? Side::BUY : Side::SELL;
+    command.quantity = quantity_(rng_);
+
+    int sign = command.side == Side::BUY ? -1 : 1;
+    if (unit_(rng_) < config_.marketable_ratio) {
+        command.price = state.mid - sign * config_.max_offset;
+    }
+    else {
+        int offset = std::min(offset_(rng_) + 1, config_.max_offset);
+        command.price = state.mid + sign * offset;
+    }
+
+    state.live.push_back(command.id);
+    return command;
+}
+
+OrderId FlowGenerator::take_live(SymbolState& state, bool remove) {
+    std::size_t i = rng_() % state.live.size();
+    OrderId id = state.live[i];
+    if (remove) {
+        state.live[i] = state.live.back();
+        state.live.pop_back();
+    }
+    return id;
+}
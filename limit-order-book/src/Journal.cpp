@@ -0,0 +1,80 @@
+#include "Journal.h"
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+Journal::Journal(const std::string& path, std::uint64_t capacity, std::chrono::milliseconds flush_interval)
+    : capacity_(capacity), flush_interval_(flush_interval)
+{
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) throw std::runtime_error("Failed to open file: " + path);
+
+    size_ = sizeof(MessageFileHeader) + capacity * sizeof(OrderCommand);
+    if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Failed to size journal: " + path);
+    }
+
+    // Populate up front so the first appends don't fault in page tables
+    int flags = MAP_SHARED;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    void* data = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, flags, fd_, 0);
+    if (data == MAP_FAILED) {
+        ::close(fd_);
+        throw std::runtime_error("Failed to map file: " + path);
+    }
+    data_ = static_cast<std::byte*>(data);
+    header_ = reinterpret_cast<MessageFileHeader*>(data_);
+    records_ = reinterpret_cast<OrderCommand*>(data_ + sizeof(MessageFileHeader));
+
+    *header_ = {};
+    std::memcpy(header_->magic, MESSAGE_FILE_MAGIC, sizeof(header_->magic));
+    header_->version = MESSAGE_FILE_VERSION;
+    header_->record_size = sizeof(OrderCommand);
+    header_->num_symbols = 1;
+    ::msync(data_, sizeof(MessageFileHeader), MS_SYNC);
+
+    flusher_ = std::jthread([this](std::stop_token stop) { flush_loop(stop); });
+}
+
+Journal::~Journal() {
+    flusher_.request_stop();
+    if (flusher_.joinable()) flusher_.join();
+
+    // A clean shutdown trims the unused tail so recovery maps only real records
+    ::munmap(data_, size_);
+    ::ftruncate(fd_, static_cast<off_t>(sizeof(MessageFileHeader) + durable() * sizeof(OrderCommand)));
+    ::close(fd_);
+}
+
+void Journal::flush() {
+    std::lock_guard lock(flush_mutex_);
+    std::uint64_t appended = appended_.load(std::memory_order_acquire);
+    std::uint64_t durable = durable_.load(std::memory_order_relaxed);
+    if (appended == durable) return;
+
+    // Records first, then the count that makes them visible to recovery
+    static const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t begin = sizeof(MessageFileHeader) + durable * sizeof(OrderCommand);
+    std::size_t end = sizeof(MessageFileHeader) + appended * sizeof(OrderCommand);
+    begin -= begin % page;
+    ::msync(data_ + begin, end - begin, MS_SYNC);
+
+    header_->count = appended;
+    ::msync(data_, sizeof(MessageFileHeader), MS_SYNC);
+    durable_.store(appended, std::memory_order_release);
+}
+
+void Journal::flush_loop(std::stop_token stop) {
+    std::mutex mutex;
+    std::unique_lock lock(mutex);
+    while (!stop.stop_requested()) {
+        flush();
+        wake_.wait_for(lock, stop, flush_interval_, [] { return false; });
+    }
+    flush();
+}
@@ -0,0 +1,80 @@
+#include "MessageFile.h"
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MessageFileWriter::MessageFileWriter(const std::string& path, std::uint32_t num_symbols)
+    : out_(path, std::ios::binary | std::ios::trunc), header_{}
+{
+    if (!out_.is_open()) throw std::runtime_error("Failed to open file: " + path);
+
+    std::memcpy(header_.magic, MESSAGE_FILE_MAGIC, sizeof(header_.magic));
+    header_.version = MESSAGE_FILE_VERSION;
+    header_.record_size = sizeof(OrderCommand);
+    header_.num_symbols = num_symbols;
+    out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+}
+
+MessageFileWriter::~MessageFileWriter() {
+    close();
+}
+
+void MessageFileWriter::write(const OrderCommand& command) {
+    out_.write(reinterpret_cast<const char*>(&command), sizeof(command));
+    ++header_.count;
+}
+
+void MessageFileWriter::close() {
+    if (!out_.is_open()) return;
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header_), sizeof(header_));
+    out_.close();
+}
+
+MappedMessageFile::MappedMessageFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Failed to open file: " + path);
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(MessageFileHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a message file: " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    // Populate up front so replay timing doesn't include page faults
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    data_ = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Failed to map file: " + path);
+    }
+    ::madvise(data_, size_, MADV_SEQUENTIAL);
+
+    const auto* header = static_cast<const MessageFileHeader*>(data_);
+    std::uint64_t available = (size_ - sizeof(MessageFileHeader)) / sizeof(OrderCommand);
+    if (std::memcmp(header->magic, MESSAGE_FILE_MAGIC, sizeof(header->magic)) != 0
+        || header->version != MESSAGE_FILE_VERSION
+        || header->record_size != sizeof(OrderCommand)
+        || header->count > available) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+        throw std::runtime_error("Not a message file: " + path);
+    }
+
+    num_symbols_ = header->num_symbols;
+    const auto* records = reinterpret_cast<const OrderCommand*>(static_cast<const char*>(data_) + sizeof(MessageFileHeader));
+    messages_ = {records, static_cast<std::size_t>(header->count)};
+}
+
+MappedMessageFile::~MappedMessageFile() {
+    if (data_) ::munmap(data_, size_);
+}
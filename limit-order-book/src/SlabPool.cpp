@@ -0,0 +1,38 @@
+#include "SlabPool.h"
+#include <algorithm>
+
+SlabPool::SlabPool(std::size_t block_size, std::size_t block_align, std::size_t blocks_per_slab)
+    : block_align_(std::max(block_align, alignof(FreeBlock))),
+      blocks_per_slab_(std::max<std::size_t>(blocks_per_slab, 1))
+{
+    // Round up so every block in a slab stays aligned and can hold a free-list link
+    std::size_t size = std::max(block_size, sizeof(FreeBlock));
+    block_size_ = (size + block_align_ - 1) / block_align_ * block_align_;
+
+    slabs_.reserve(16);
+    add_slab();
+    heap_allocations_ = 0; // The startup slab is the preallocation, not a miss
+}
+
+void SlabPool::add_slab() {
+    auto* raw = static_cast<std::byte*>(
+        ::operator new(block_size_ * blocks_per_slab_, std::align_val_t{block_align_}));
+    slabs_.emplace_back(raw, SlabDeleter{block_align_});
+    ++heap_allocations_;
+
+    // Thread the new blocks onto the free list in address order
+    for (std::size_t i = blocks_per_slab_; i-- > 0;) {
+        auto* block = reinterpret_cast<FreeBlock*>(raw + i * block_size_);
+        block->next = free_;
+        free_ = block;
+    }
+}
+
+void* SlabPool::allocate_oversize(std::size_t bytes, std::size_t align) {
+    ++heap_allocations_;
+    return ::operator new(bytes, std::align_val_t{align});
+}
+
+void SlabPool::deallocate_oversize(void* p, std::size_t align) {
+    ::operator delete(p, std::align_val_t{align});
+}
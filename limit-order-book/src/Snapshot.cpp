@@ -0,0 +1,130 @@
+#include "Snapshot.h"
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t WRITE_BUFFER = 1 << 20;
+
+bool valid_header(const SnapshotHeader& header) {
+    return std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0
+        && header.version == SNAPSHOT_VERSION;
+}
+
+void write_all(int fd, const std::byte* data, std::size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written <= 0) throw std::runtime_error("Failed to write snapshot");
+        data += written;
+        size -= static_cast<std::size_t>(written);
+    }
+}
+
+}
+
+SnapshotWriter::SnapshotWriter(const std::string& path, std::uint32_t record_size,
+                               std::uint64_t generation, std::uint64_t journal_count)
+    : path_(path), tmp_path_(path + ".tmp"), header_{}
+{
+    fd_ = ::open(tmp_path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) throw std::runtime_error("Failed to open file: " + tmp_path_);
+
+    std::memcpy(header_.magic, SNAPSHOT_MAGIC, sizeof(header_.magic));
+    header_.version = SNAPSHOT_VERSION;
+    header_.record_size = record_size;
+    header_.generation = generation;
+    header_.journal_count = journal_count;
+
+    // Count is patched on commit
+    buffer_.reserve(WRITE_BUFFER);
+    const auto* bytes = reinterpret_cast<const std::byte*>(&header_);
+    buffer_.insert(buffer_.end(), bytes, bytes + sizeof(header_));
+}
+
+SnapshotWriter::~SnapshotWriter() {
+    // Not committed: drop the partial file
+    if (fd_ >= 0) {
+        ::close(fd_);
+        std::remove(tmp_path_.c_str());
+    }
+}
+
+void SnapshotWriter::write(const void* records, std::size_t count) {
+    const auto* bytes = static_cast<const std::byte*>(records);
+    std::size_t size = count * header_.record_size;
+    if (buffer_.size() + size > WRITE_BUFFER) drain();
+    if (size >= WRITE_BUFFER) write_all(fd_, bytes, size);
+    else buffer_.insert(buffer_.end(), bytes, bytes + size);
+    header_.count += count;
+}
+
+void SnapshotWriter::drain() {
+    write_all(fd_, buffer_.data(), buffer_.size());
+    buffer_.clear();
+}
+
+void SnapshotWriter::commit() {
+    drain();
+    if (::pwrite(fd_, &header_, sizeof(header_), 0) != static_cast<ssize_t>(sizeof(header_))
+        || ::fsync(fd_) != 0) {
+        throw std::runtime_error("Failed to write snapshot: " + tmp_path_);
+    }
+    ::close(fd_);
+    fd_ = -1;
+    if (std::rename(tmp_path_.c_str(), path_.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace snapshot: " + path_);
+    }
+}
+
+MappedSnapshot::MappedSnapshot(const std::string& path, std::uint32_t record_size) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Failed to open file: " + path);
+
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(SnapshotHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a snapshot: " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    flags |= MAP_POPULATE;
+#endif
+    data_ = ::mmap(nullptr, size_, PROT_READ, flags, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Failed to map file: " + path);
+    }
+    ::madvise(data_, size_, MADV_SEQUENTIAL);
+
+    const SnapshotHeader& h = header();
+    std::uint64_t available = (size_ - sizeof(SnapshotHeader)) / record_size;
+    if (!valid_header(h) || h.record_size != record_size || h.count > available) {
+        ::munmap(data_, size_);
+        data_ = nullptr;
+        throw std::runtime_error("Not a snapshot: " + path);
+    }
+}
+
+MappedSnapshot::~MappedSnapshot() {
+    if (data_) ::munmap(data_, size_);
+}
+
+std::optional<SnapshotHeader> read_snapshot_header(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return std::nullopt;
+
+    SnapshotHeader header{};
+    ssize_t read = ::read(fd, &header, sizeof(header));
+    ::close(fd);
+    if (read != static_cast<ssize_t>(sizeof(header)) || !valid_header(header)) return std::nullopt;
+    return header;
+}
@@ -1,31 +1,40 @@
+#include "ExecutionReport.h"
 #include "LimitOrderBook.h"
 #include "Order.h"
 #include <iostream>
 
 int main() {
-    LimitOrderBook book;
+    auto print_report = [](const ExecutionReport& report) {
+        std::cout << "  " << report << std::endl;
+    };
+    LimitOrderBook<MapLevels, decltype(print_report)> book({}, print_report);
 
     std::cout << std::endl << "Adding initial resting orders" << std::endl;
-    book.add_order({Side::SELL, 100, 102}); // Ask 100 @ 102
-    book.add_order({Side::SELL, 50,  101}); // Ask 50 @ 101
-    book.add_order({Side::BUY,  40,  99});  // Bid 40 @ 99
-    book.add_order({Side::BUY,  25,  98});  // Bid 25 @ 98
+    book.add_order({1, Side::SELL, 100, 102}); // Ask 100 @ 102
+    book.add_order({2, Side::SELL, 50,  101}); // Ask 50 @ 101
+    book.add_order({3, Side::BUY,  40,  99});  // Bid 40 @ 99
+    book.add_order({4, Side::BUY,  25,  98});  // Bid 25 @ 98
     book.print_book();
 
-    Order order = {Side::BUY, 10, 200};
+    Order order = {5, Side::BUY, 10, 200};
     std::cout << std:: endl << "Partial fill: " << order << std::endl;
     book.add_order(order);
     book.print_book();
 
-    order = {Side::BUY, 150, 150};
+    order = {6, Side::BUY, 150, 150};
     std::cout << std:: endl << "Removing liquidity: " << order << std::endl;
-    book.add_order(order);    
+    book.add_order(order);
     book.print_book();
 
-    order = {Side::SELL, 10, 150};
+    order = {7, Side::SELL, 10, 150};
     std::cout << std:: endl << "Matches and full fills: " << order << std::endl;
-    book.add_order(order);    
+    book.add_order(order);
+    book.print_book();
+
+    std::cout << std::endl << "Cancel #4, reduce #3 to 15" << std::endl;
+    book.cancel_order(4);
+    book.modify_order(3, 15);
     book.print_book();
 
     return 0;
-}
\ No newline at end of file
+}
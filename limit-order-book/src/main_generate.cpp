@@ -0,0 +1,56 @@
+#include "FeedSink.h"
+#include "FlowGenerator.h"
+#include "LimitOrderBook.h"
+#include "MessageFile.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Writes a synthetic capture for lob_replay. With "l3" the flow is matched
+// first and the file holds the order-by-order feed a venue would publish
+// for it (one message per rest, execute, cancel and modify), for replaying
+// in builder mode.
+// Usage: lob_generate <out.bin> [messages] [symbols] [seed] [orders|l3]
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <out.bin> [messages=10000000] [symbols=1] [seed=42] [orders|l3]" << std::endl;
+        return 1;
+    }
+
+    std::string path = argv[1];
+    std::uint64_t messages = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10'000'000;
+
+    FlowConfig config;
+    if (argc > 3) config.num_symbols = static_cast<std::uint32_t>(std::strtoul(argv[3], nullptr, 10));
+    if (argc > 4) config.seed = std::strtoull(argv[4], nullptr, 10);
+
+    bool l3 = argc > 5 && std::string_view(argv[5]) == "l3";
+
+    FlowGenerator generator(config);
+    MessageFileWriter writer(path, config.num_symbols);
+    if (!l3) {
+        for (std::uint64_t i = 0; i < messages; ++i) writer.write(generator.next());
+    }
+    else {
+        using FeedBook = LimitOrderBook<PriceLadder, FeedSink>;
+        std::vector<OrderCommand> feed;
+        std::vector<std::unique_ptr<FeedBook>> books;
+        for (SymbolId s = 0; s < config.num_symbols; ++s) {
+            books.push_back(std::make_unique<FeedBook>(BookConfig{}, FeedSink(feed, s)));
+        }
+        for (std::uint64_t i = 0; i < messages; ++i) {
+            OrderCommand command = generator.next();
+            apply(*books[command.symbol], command);
+            for (const OrderCommand& message : feed) writer.write(message);
+            feed.clear();
+        }
+    }
+    writer.close();
+
+    std::cout << "Wrote " << writer.count() << " messages for " << config.num_symbols
+              << " symbol(s) to: " << path << std::endl;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "BookManager.h"
+
+namespace {
+
+OrderCommand add(SymbolId symbol, OrderId id, Side side, int quantity, int price) {
+    return {.id = id, .symbol = symbol, .quantity = quantity, .price = price, .type = CommandType::ADD, .side = side};
+}
+
+OrderCommand cancel(SymbolId symbol, OrderId id) {
+    return {.id = id, .symbol = symbol, .type = CommandType::CANCEL};
+}
+
+void route_all(BookManager<>& manager, const OrderCommand& command) {
+    while (!manager.route(command)) std::this_thread::yield();
+}
+
+}
+
+TEST(BookManagerTest, ShardsSymbolsRoundRobin) {
+    BookManager<> manager(10, 4);
+    EXPECT_EQ(manager.shard_of(0), 0u);
+    EXPECT_EQ(manager.shard_of(5), 1u);
+    EXPECT_EQ(manager.shard_of(7), 3u);
+
+    // Each symbol has its own book
+    manager.book(5).add_order({1, Side::BUY, 10, 100});
+    EXPECT_EQ(manager.book(5).best_bid(), 100);
+    EXPECT_EQ(manager.book(1).best_bid(), std::nullopt);
+}
+
+TEST(BookManagerTest, RejectsUnknownSymbol) {
+    BookManager<> manager(4, 2);
+    EXPECT_FALSE(manager.route(add(4, 1, Side::BUY, 10, 100)));
+}
+
+TEST(BookManagerTest, ShardThreadsApplyRoutedCommands) {
+    static constexpr SymbolId NUM_SYMBOLS = 16;
+    static constexpr int ORDERS_PER_SYMBOL = 2'000;
+    BookManager<> manager(NUM_SYMBOLS, 4);
+    manager.start();
+
+    // Per symbol: rest bids at 100, cancel every other one, then one sell
+    // that takes out exactly one remaining bid
+    for (int i = 0; i < ORDERS_PER_SYMBOL; ++i) {
+        for (SymbolId s = 0; s < NUM_SYMBOLS; ++s) {
+            route_all(manager, add(s, static_cast<OrderId>(i), Side::BUY, 1, 100));
+        }
+    }
+    for (int i = 0; i < ORDERS_PER_SYMBOL; i += 2) {
+        for (SymbolId s = 0; s < NUM_SYMBOLS; ++s) route_all(manager, cancel(s, static_cast<OrderId>(i)));
+    }
+    for (SymbolId s = 0; s < NUM_SYMBOLS; ++s) {
+        route_all(manager, add(s, ORDERS_PER_SYMBOL, Side::SELL, 1, 100));
+    }
+
+    manager.stop();
+
+    std::uint64_t total = 0;
+    for (std::size_t shard = 0; shard < manager.num_shards(); ++shard) total += manager.processed(shard);
+    EXPECT_EQ(total, NUM_SYMBOLS * (ORDERS_PER_SYMBOL + ORDERS_PER_SYMBOL / 2 + 1u));
+
+    for (SymbolId s = 0; s < NUM_SYMBOLS; ++s) {
+        EXPECT_EQ(manager.book(s).volume_at(Side::BUY, 100), ORDERS_PER_SYMBOL / 2 - 1);
+        EXPECT_EQ(manager.book(s).best_ask(), std::nullopt);
+    }
+}
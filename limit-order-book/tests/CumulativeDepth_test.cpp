@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "CumulativeDepth.h"
+#include <cstdint>
+#include <map>
+#include <random>
+
+namespace {
+
+// Reference: sum the map directly
+template <Side S>
+std::int64_t brute_through(const std::map<int, int>& levels, int limit) {
+    std::int64_t sum = 0;
+    for (auto [price, quantity] : levels) {
+        if (S == Side::SELL ? price <= limit : price >= limit) sum += quantity;
+    }
+    return sum;
+}
+
+template <Side S>
+void check_random_walk(std::uint64_t seed, const BookConfig& config = {64, 0}, int band = 20) {
+    CumulativeDepth<S> depth(config);
+    std::map<int, int> levels;
+    std::mt19937 rng(seed);
+    int mid = 0;
+
+    for (int step = 0; step < 20'000; ++step) {
+        // The band drifts far past the initial 64-tick window
+        if (step % 50 == 0) mid += static_cast<int>(rng() % 7) - 2;
+        int price = mid + static_cast<int>(rng() % (2 * band)) - band;
+        int quantity = rng() % 3 == 0 ? 0 : static_cast<int>(rng() % 100);
+        depth.set(price, quantity);
+        if (quantity) levels[price] = quantity;
+        else levels.erase(price);
+
+        // Drop anything that fell far behind the band, as fills would
+        for (auto it = levels.begin(); it != levels.end();) {
+            if (it->first < mid - 3 * band || it->first > mid + 3 * band) {
+                depth.set(it->first, 0);
+                it = levels.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+
+        int limit = mid + static_cast<int>(rng() % (5 * band)) - 5 * band / 2;
+        ASSERT_EQ(depth.through(limit), brute_through<S>(levels, limit)) << "step " << step;
+    }
+}
+
+}
+
+TEST(CumulativeDepthTest, AsksSumAtOrBelowLimit) {
+    CumulativeDepth<Side::SELL> asks;
+    asks.set(100, 10);
+    asks.set(101, 20);
+    asks.set(105, 5);
+
+    EXPECT_EQ(asks.through(99), 0);
+    EXPECT_EQ(asks.through(100), 10);
+    EXPECT_EQ(asks.through(104), 30);
+    EXPECT_EQ(asks.through(1'000'000), 35);
+
+    asks.set(101, 0);
+    EXPECT_EQ(asks.through(104), 10);
+    EXPECT_EQ(asks.total(), 15);
+}
+
+TEST(CumulativeDepthTest, BidsSumAtOrAboveLimit) {
+    CumulativeDepth<Side::BUY> bids;
+    bids.set(99, 10);
+    bids.set(98, 20);
+
+    EXPECT_EQ(bids.through(100), 0);
+    EXPECT_EQ(bids.through(99), 10);
+    EXPECT_EQ(bids.through(98), 30);
+    EXPECT_EQ(bids.through(-1'000'000), 30);
+}
+
+TEST(CumulativeDepthTest, MatchesBruteForceWhileWindowDrifts) {
+    check_random_walk<Side::SELL>(1);
+    check_random_walk<Side::BUY>(2);
+}
+
+TEST(CumulativeDepthTest, MatchesBruteForceWithLevelsPastTheWindow) {
+    // Capped at 128 ticks, a 300-tick band keeps spilling levels past the window
+    check_random_walk<Side::SELL>(3, BookConfig{64, 0, 128}, 50);
+    check_random_walk<Side::BUY>(4, BookConfig{64, 0, 128}, 50);
+}
+
+TEST(CumulativeDepthTest, WidelySpacedLevelsStaySparse) {
+    CumulativeDepth<Side::SELL> asks(BookConfig{64, 0});
+    asks.set(100, 10);
+    asks.set(100'000'000, 20);
+    asks.set(2'000'000'000, 5);
+
+    EXPECT_EQ(asks.window(), 64u);
+    EXPECT_EQ(asks.far_levels(), 2u);
+    EXPECT_EQ(asks.through(99), 0);
+    EXPECT_EQ(asks.through(100), 10);
+    EXPECT_EQ(asks.through(99'999'999), 10);
+    EXPECT_EQ(asks.through(100'000'000), 30);
+    EXPECT_EQ(asks.through(2'000'000'000), 35);
+
+    // Emptied, the window moves to the nearest far level
+    asks.set(100, 0);
+    EXPECT_EQ(asks.far_levels(), 1u);
+    EXPECT_EQ(asks.through(100), 0);
+    EXPECT_EQ(asks.through(100'000'000), 20);
+    EXPECT_EQ(asks.through(2'000'000'000), 25);
+
+    // A new best ahead of the window takes it back
+    asks.set(-2'000'000'000, 1);
+    EXPECT_EQ(asks.far_levels(), 2u);
+    EXPECT_EQ(asks.through(0), 1);
+    EXPECT_EQ(asks.through(2'000'000'000), 26);
+    EXPECT_EQ(asks.window(), 64u);
+    EXPECT_EQ(asks.heap_allocations(), 0u);
+}
+
+TEST(CumulativeDepthTest, WidelySpacedBidsStaySparse) {
+    CumulativeDepth<Side::BUY> bids(BookConfig{64, 0});
+    bids.set(2'000'000'000, 5);
+    bids.set(100, 10);
+    bids.set(-2'000'000'000, 20);
+
+    EXPECT_EQ(bids.window(), 64u);
+    EXPECT_EQ(bids.far_levels(), 2u);
+    EXPECT_EQ(bids.through(2'000'000'000), 5);
+    EXPECT_EQ(bids.through(101), 5);
+    EXPECT_EQ(bids.through(100), 15);
+    EXPECT_EQ(bids.through(-2'000'000'000), 35);
+
+    bids.set(2'000'000'000, 0);
+    EXPECT_EQ(bids.far_levels(), 1u);
+    EXPECT_EQ(bids.through(100), 10);
+    EXPECT_EQ(bids.through(-2'000'000'000), 30);
+}
+
+TEST(CumulativeDepthTest, RecentringWithinBandDoesNotAllocate) {
+    CumulativeDepth<Side::SELL> asks(BookConfig{64, 0});
+    for (int price = 0; price < 10'000; ++price) {
+        asks.set(price, 1);
+        if (price >= 10) asks.set(price - 10, 0);
+    }
+    EXPECT_EQ(asks.total(), 10);
+    EXPECT_EQ(asks.heap_allocations(), 0u);
+
+    // A span wider than half the window doubles it
+    asks.set(20'000, 1);
+    EXPECT_GT(asks.heap_allocations(), 0u);
+    EXPECT_EQ(asks.through(20'000), 11);
+}
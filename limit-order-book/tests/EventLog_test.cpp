@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include "EventLog.h"
+#include "LimitOrderBook.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+std::vector<std::string> read_lines(const std::string& path) {
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+    return lines;
+}
+
+bool any_line_contains(const std::vector<std::string>& lines, const std::string& text) {
+    for (const std::string& line : lines) {
+        if (line.find(text) != std::string::npos) return true;
+    }
+    return false;
+}
+
+}
+
+TEST(EventLogTest, ReportsAndBookDumpsAreFormattedToTheFile) {
+    std::string path = temp_path("lob_event_log.txt");
+    {
+        EventLog log(path);
+        LogChannel& channel = log.channel();
+        LimitOrderBook<PriceLadder, LogSink> book({}, LogSink(channel));
+        book.add_order({1, Side::SELL, 5, 101});
+        book.add_order({2, Side::BUY, 10, 99});
+        book.add_order({3, Side::BUY, 2, 101});
+        book.log_book(channel);
+        channel.mark("end of session");
+        log.flush();
+
+        auto lines = read_lines(path);
+        EXPECT_EQ(lines.size(), log.written());
+        EXPECT_TRUE(any_line_contains(lines, "REST #1 SELL 5 at 101"));
+        EXPECT_TRUE(any_line_contains(lines, "FILL #3 BUY 2 at 101 (leaves 0) vs #1"));
+        EXPECT_TRUE(any_line_contains(lines, "--- ORDER BOOK"));
+        EXPECT_TRUE(any_line_contains(lines, "ASK 101: 3 (1 orders)"));
+        EXPECT_TRUE(any_line_contains(lines, "BID 99: 10 (1 orders)"));
+        EXPECT_NE(lines.back().find("end of session"), std::string::npos);
+        EXPECT_EQ(channel.dropped(), 0u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(EventLogTest, FullRingWaitsForTheLogThreadAndLosesNothing) {
+    std::string path = temp_path("lob_event_log_block.txt");
+    {
+        // Poll interval far beyond the test: only the channel's wakes drain it
+        EventLog log(path, 4, std::chrono::hours(1));
+        LogChannel& channel = log.channel();
+        LimitOrderBook<PriceLadder, LogSink> book({}, LogSink(channel));
+        for (OrderId id = 1; id <= 50; ++id) book.add_order({id, Side::BUY, 1, static_cast<int>(90 + id % 10)});
+        book.log_book(channel);
+        log.flush();
+
+        EXPECT_EQ(channel.dropped(), 0u);
+        EXPECT_GT(channel.stalls(), 0u);
+        // 50 rests, then begin + 10 levels + end
+        EXPECT_EQ(log.written(), 62u);
+        EXPECT_EQ(read_lines(path).size(), 62u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(EventLogTest, DropChannelDiscardsInsteadOfBlocking) {
+    std::string path = temp_path("lob_event_log_full.txt");
+    {
+        EventLog log(path, 4, std::chrono::hours(1));
+        LogChannel& channel = log.channel(LogOverflow::DROP);
+        for (int i = 0; i < 100; ++i) channel.mark("x");
+        log.flush();
+
+        EXPECT_GT(channel.dropped(), 0u);
+        EXPECT_EQ(log.written() + channel.dropped(), 100u);
+        EXPECT_THROW(LogSink{channel}, std::invalid_argument);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(EventLogTest, TimestampsAreSteadyClockNanoseconds) {
+    std::string path = temp_path("lob_event_log_time.txt");
+    auto now = [] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    };
+    long long before = 0;
+    long long after = 0;
+    {
+        EventLog log(path);
+        LogChannel& channel = log.channel();
+        before = now();
+        channel.mark("now");
+        after = now();
+    }
+    auto lines = read_lines(path);
+    ASSERT_EQ(lines.size(), 1u);
+    long long stamp = std::stoll(lines[0]);
+    // Calibration error allowance: well under a millisecond either way
+    EXPECT_GT(stamp, before - 1'000'000);
+    EXPECT_LT(stamp, after + 1'000'000);
+    std::filesystem::remove(path);
+}
+
+TEST(EventLogTest, EachChannelKeepsItsOrder) {
+    std::string path = temp_path("lob_event_log_threads.txt");
+    constexpr int THREADS = 4;
+    constexpr int RECORDS = 5000;
+    {
+        EventLog log(path);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&log, t] {
+                LogChannel& channel = log.channel();
+                for (int i = 0; i < RECORDS; ++i) {
+                    std::string text = std::to_string(t) + " " + std::to_string(i);
+                    while (!channel.mark(text.c_str())) std::this_thread::yield();
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    }
+
+    // "<timestamp> [<channel>] <thread> <i>"
+    std::map<int, int> next;
+    auto lines = read_lines(path);
+    ASSERT_EQ(lines.size(), static_cast<std::size_t>(THREADS * RECORDS));
+    for (const std::string& line : lines) {
+        std::istringstream in(line.substr(line.find(']') + 1));
+        int thread = 0;
+        int i = 0;
+        in >> thread >> i;
+        ASSERT_EQ(i, next[thread]) << line;
+        ++next[thread];
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+#include "LimitOrderBook.h"
+#include <atomic>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct CollectingSink {
+    std::vector<ExecutionReport>* out;
+    void operator()(const ExecutionReport& report) const { out->push_back(report); }
+};
+
+// Takes whole chunks when the book offers them
+struct ChunkSink {
+    std::vector<ExecutionReport>* out;
+    std::size_t* chunks;
+    void operator()(const ExecutionReport& report) const { out->push_back(report); }
+    void operator()(std::span<const ExecutionReport> reports) const {
+        out->insert(out->end(), reports.begin(), reports.end());
+        ++*chunks;
+    }
+};
+
+using Book = LimitOrderBook<PriceLadder, CollectingSink>;
+
+}
+
+TEST(ExecutionReportTest, RestThenFillReportsBothSides) {
+    std::vector<ExecutionReport> reports;
+    Book book({}, CollectingSink{&reports});
+
+    book.add_order({1, Side::SELL, 10, 100});
+    ASSERT_EQ(reports.size(), 1u);
+    EXPECT_EQ(reports[0].type, ExecType::REST);
+    EXPECT_EQ(reports[0].leaves_quantity, 10);
+
+    reports.clear();
+    book.add_order({2, Side::BUY, 4, 101});
+    ASSERT_EQ(reports.size(), 2u);
+
+    // Resting side first, traded at the resting price
+    EXPECT_EQ(reports[0].type, ExecType::PARTIAL_FILL);
+    EXPECT_EQ(reports[0].order_id, 1u);
+    EXPECT_EQ(reports[0].contra_id, 2u);
+    EXPECT_EQ(reports[0].price, 100);
+    EXPECT_EQ(reports[0].quantity, 4);
+    EXPECT_EQ(reports[0].leaves_quantity, 6);
+
+    EXPECT_EQ(reports[1].type, ExecType::FILL);
+    EXPECT_EQ(reports[1].order_id, 2u);
+    EXPECT_EQ(reports[1].side, Side::BUY);
+    EXPECT_EQ(reports[1].leaves_quantity, 0);
+}
+
+TEST(ExecutionReportTest, SweepRestsRemainder) {
+    std::vector<ExecutionReport> reports;
+    Book book({}, CollectingSink{&reports});
+    book.add_order({1, Side::SELL, 5, 100});
+    book.add_order({2, Side::SELL, 5, 101});
+    reports.clear();
+
+    book.add_order({3, Side::BUY, 15, 101});
+
+    ASSERT_EQ(reports.size(), 5u);
+    EXPECT_EQ(reports[0].type, ExecType::FILL);
+    EXPECT_EQ(reports[1].type, ExecType::PARTIAL_FILL);
+    EXPECT_EQ(reports[1].leaves_quantity, 10);
+    EXPECT_EQ(reports[2].type, ExecType::FILL);
+    EXPECT_EQ(reports[3].leaves_quantity, 5);
+    EXPECT_EQ(reports[4].type, ExecType::REST);
+    EXPECT_EQ(reports[4].order_id, 3u);
+    EXPECT_EQ(reports[4].quantity, 5);
+}
+
+TEST(ExecutionReportTest, CancelModifyAndReject) {
+    std::vector<ExecutionReport> reports;
+    Book book({}, CollectingSink{&reports});
+    book.add_order({1, Side::BUY, 10, 99});
+    reports.clear();
+
+    book.modify_order(1, 7);
+    book.cancel_order(1);
+    book.add_order({2, Side::BUY, 0, 99});
+
+    ASSERT_EQ(reports.size(), 3u);
+    EXPECT_EQ(reports[0].type, ExecType::MODIFY);
+    EXPECT_EQ(reports[0].quantity, 7);
+    EXPECT_EQ(reports[1].type, ExecType::CANCEL);
+    EXPECT_EQ(reports[1].quantity, 7);
+    EXPECT_EQ(reports[1].leaves_quantity, 0);
+    EXPECT_EQ(reports[2].type, ExecType::REJECT);
+    EXPECT_EQ(reports[2].order_id, 2u);
+}
+
+TEST(ExecutionReportTest, UnfilledIocAndKilledFokExpire) {
+    std::vector<ExecutionReport> reports;
+    Book book({}, CollectingSink{&reports});
+    book.add_order({1, Side::SELL, 10, 100});
+    reports.clear();
+
+    book.add_order({2, Side::BUY, 4, 100, OrderType::FOK, 0});
+    book.add_order({3, Side::BUY, 20, 100, OrderType::FOK});
+    book.add_order({4, Side::BUY, 10, 101, OrderType::IOC});
+
+    ASSERT_EQ(reports.size(), 6u);
+    EXPECT_EQ(reports[1].type, ExecType::FILL);
+    EXPECT_EQ(reports[1].order_id, 2u);
+    EXPECT_EQ(reports[2].type, ExecType::EXPIRE);
+    EXPECT_EQ(reports[2].order_id, 3u);
+    EXPECT_EQ(reports[2].quantity, 20);
+    EXPECT_EQ(reports[3].type, ExecType::FILL);
+    EXPECT_EQ(reports[3].leaves_quantity, 0);
+    EXPECT_EQ(reports[5].type, ExecType::EXPIRE);
+    EXPECT_EQ(reports[5].quantity, 4);
+    EXPECT_EQ(reports[5].price, 101);
+}
+
+TEST(ExecutionReportTest, BatchReportsMatchSingleOrderStreamInChunks) {
+    std::vector<Order> orders;
+    for (int i = 0; i < 300; ++i) {
+        orders.push_back({static_cast<OrderId>(i + 1), i % 2 ? Side::SELL : Side::BUY, 1 + i % 3, 100});
+    }
+
+    std::vector<ExecutionReport> expected;
+    Book single({}, CollectingSink{&expected});
+    for (const Order& order : orders) single.add_order(order);
+
+    std::vector<ExecutionReport> reports;
+    std::size_t chunks = 0;
+    LimitOrderBook<PriceLadder, ChunkSink> batched({}, ChunkSink{&reports, &chunks});
+    EXPECT_EQ(batched.add_orders(orders), orders.size());
+
+    ASSERT_EQ(reports.size(), expected.size());
+    for (std::size_t i = 0; i < reports.size(); ++i) {
+        EXPECT_EQ(reports[i].type, expected[i].type);
+        EXPECT_EQ(reports[i].order_id, expected[i].order_id);
+        EXPECT_EQ(reports[i].quantity, expected[i].quantity);
+    }
+    EXPECT_LT(chunks, reports.size() / 32);
+
+    // Outside a batch a span-capable sink still gets single reports
+    chunks = 0;
+    batched.add_order({1'000, Side::BUY, 1, 90});
+    EXPECT_EQ(chunks, 0u);
+}
+
+TEST(ExecutionReportTest, RingSinkDeliversAcrossThreads) {
+    static constexpr int NUM_ORDERS = 100'000;
+    SpscRing<ExecutionReport> ring(1024);
+    LimitOrderBook<PriceLadder, RingSink> book({}, RingSink{ring});
+
+    std::atomic<bool> done{false};
+    std::size_t received = 0;
+    std::jthread consumer([&] {
+        ExecutionReport report;
+        while (true) {
+            if (ring.try_pop(report)) ++received;
+            else if (done) {
+                while (ring.try_pop(report)) ++received;
+                break;
+            }
+        }
+    });
+
+    // Alternating sides at one price: every other order fills the previous
+    for (int i = 0; i < NUM_ORDERS; ++i) {
+        book.add_order({static_cast<OrderId>(i + 1), i % 2 ? Side::SELL : Side::BUY, 1, 100});
+    }
+    done = true;
+    consumer.join();
+
+    // Half the orders rest (1 report), half trade (2 reports)
+    EXPECT_EQ(received + book.sink().dropped(), NUM_ORDERS / 2 * 3u);
+}
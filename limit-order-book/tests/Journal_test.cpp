@@ -0,0 +1,331 @@
+#include <gtest/gtest.h>
+#include "BookRecorder.h"
+#include "FlowGenerator.h"
+#include "Journal.h"
+#include "LimitOrderBook.h"
+#include "MessageFile.h"
+#include "Snapshot.h"
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+using Book = LimitOrderBook<PriceLadder>;
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Fresh empty directory per test
+std::string temp_dir(const char* name) {
+    std::string dir = temp_path(name);
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+std::vector<Book::RestingOrder> resting_orders(const Book& book) {
+    std::vector<Book::RestingOrder> orders;
+    book.for_each_order([&](const Book::RestingOrder& order) { orders.push_back(order); });
+    return orders;
+}
+
+void expect_same_book(const Book& a, const Book& b) {
+    EXPECT_EQ(a.best_bid(), b.best_bid());
+    EXPECT_EQ(a.best_ask(), b.best_ask());
+    auto x = resting_orders(a);
+    auto y = resting_orders(b);
+    ASSERT_EQ(x.size(), y.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        EXPECT_EQ(x[i].id, y[i].id);
+        EXPECT_EQ(x[i].side, y[i].side);
+        EXPECT_EQ(x[i].quantity, y[i].quantity);
+        EXPECT_EQ(x[i].price, y[i].price);
+        EXPECT_EQ(x[i].visible, y[i].visible);
+    }
+}
+
+}
+
+TEST(JournalTest, FlushedRecordsReplayThroughMappedMessageFile) {
+    std::string path = temp_path("lob_journal_test.bin");
+    FlowGenerator generator(FlowConfig{.seed = 3});
+    std::vector<OrderCommand> written;
+    {
+        Journal journal(path, 4096);
+        for (int i = 0; i < 1000; ++i) {
+            written.push_back(generator.next());
+            ASSERT_TRUE(journal.append(written.back()));
+        }
+        journal.flush();
+        EXPECT_EQ(journal.durable(), 1000u);
+
+        // Readable while still open, as after a crash
+        MappedMessageFile file(path);
+        EXPECT_EQ(file.messages().size(), 1000u);
+    }
+
+    MappedMessageFile file(path);
+    ASSERT_EQ(file.messages().size(), written.size());
+    EXPECT_EQ(std::filesystem::file_size(path), sizeof(MessageFileHeader) + written.size() * sizeof(OrderCommand));
+    for (std::size_t i = 0; i < written.size(); ++i) {
+        EXPECT_EQ(file.messages()[i].id, written[i].id);
+        EXPECT_EQ(file.messages()[i].type, written[i].type);
+        EXPECT_EQ(file.messages()[i].quantity, written[i].quantity);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(JournalTest, BackgroundThreadFlushesWithoutBeingAsked) {
+    std::string path = temp_path("lob_journal_background.bin");
+    Journal journal(path, 16);
+    ASSERT_TRUE(journal.append(OrderCommand{.id = 1, .quantity = 10, .price = 100, .type = CommandType::ADD, .side = Side::BUY}));
+    for (int i = 0; i < 1000 && journal.durable() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(journal.durable(), 1u);
+    std::filesystem::remove(path);
+}
+
+TEST(JournalTest, AppendFailsAtCapacity) {
+    std::string path = temp_path("lob_journal_full.bin");
+    Journal journal(path, 2);
+    OrderCommand command{.id = 1, .quantity = 10, .price = 100, .type = CommandType::ADD, .side = Side::BUY};
+    EXPECT_TRUE(journal.append(command));
+    EXPECT_TRUE(journal.append(command));
+    EXPECT_FALSE(journal.append(command));
+    EXPECT_EQ(journal.count(), 2u);
+    std::filesystem::remove(path);
+}
+
+TEST(SnapshotTest, RejectsRecordsOfAnotherSize) {
+    std::string path = temp_path("lob_snapshot_size.bin");
+    {
+        SnapshotWriter writer(path, sizeof(Order), 0, 0);
+        Order order{1, Side::BUY, 10, 100};
+        writer.write(&order, 1);
+        writer.commit();
+    }
+    EXPECT_NO_THROW(MappedSnapshot(path, sizeof(Order)));
+    EXPECT_THROW(MappedSnapshot(path, sizeof(BasicOrder<std::int64_t, std::int64_t>)), std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(SnapshotTest, UncommittedWriteLeavesPreviousSnapshot) {
+    std::string path = temp_path("lob_snapshot_atomic.bin");
+    {
+        SnapshotWriter writer(path, sizeof(Order), 7, 0);
+        writer.commit();
+    }
+    {
+        SnapshotWriter writer(path, sizeof(Order), 8, 0);
+        Order order{1, Side::BUY, 10, 100};
+        writer.write(&order, 1);
+    }
+    auto header = read_snapshot_header(path);
+    ASSERT_TRUE(header);
+    EXPECT_EQ(header->generation, 7u);
+    EXPECT_EQ(header->count, 0u);
+    EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
+
+TEST(BookRecorderTest, RecoveryRebuildsTheSameBook) {
+    std::string dir = temp_dir("lob_recorder_test");
+    Book book;
+    BookRecorder recorder(book, dir, RecorderConfig{.snapshot_interval = 3000});
+    FlowGenerator generator(FlowConfig{.seed = 11});
+    for (int i = 0; i < 20'000; ++i) recorder.apply(generator.next());
+    recorder.flush();
+
+    // Recover while the recorder is still live, as after a crash
+    Book recovered;
+    RecoveryStats stats = BookRecorder<Book>::recover(recovered, dir);
+    EXPECT_GT(stats.restored_orders, 0u);
+    EXPECT_GT(stats.replayed_messages, 0u);
+    expect_same_book(book, recovered);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BookRecorderTest, FullJournalRollsOverToNewGeneration) {
+    std::string dir = temp_dir("lob_recorder_rotate");
+    Book book;
+    BookRecorder recorder(book, dir, RecorderConfig{.journal_capacity = 1000, .snapshot_interval = 1 << 20});
+    FlowGenerator generator(FlowConfig{.seed = 5});
+    for (int i = 0; i < 10'000; ++i) recorder.apply(generator.next());
+    recorder.flush();
+
+    EXPECT_GT(recorder.generation(), 0u);
+    EXPECT_FALSE(std::filesystem::exists(dir + "/journal-0.bin"));
+
+    Book recovered;
+    BookRecorder<Book>::recover(recovered, dir);
+    expect_same_book(book, recovered);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BookRecorderTest, FirstSnapshotIsCommittedBeforeAnyCommand) {
+    std::string dir = temp_dir("lob_recorder_first");
+    Book book;
+    ASSERT_TRUE(book.add_order({1, Side::BUY, 10, 99}));
+    {
+        BookRecorder recorder(book, dir);
+
+        // No flush: a crash from here on still finds the starting book
+        auto header = read_snapshot_header(dir + "/snapshot.bin");
+        ASSERT_TRUE(header);
+        EXPECT_EQ(header->generation, 0u);
+        EXPECT_EQ(header->count, 1u);
+
+        // The writer has the next journal mapped before any rollover needs it
+        recorder.flush();
+        EXPECT_TRUE(std::filesystem::exists(dir + "/journal-1.bin"));
+    }
+    EXPECT_FALSE(std::filesystem::exists(dir + "/journal-1.bin"));
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BookRecorderTest, RolloverRecoversBeforeItsSnapshotCommits) {
+    std::string dir = temp_dir("lob_recorder_uncommitted");
+    Book book;
+    BookRecorder recorder(book, dir, RecorderConfig{.journal_capacity = 1000, .snapshot_interval = 1 << 20});
+
+    // Every later snapshot fails to commit, as if the process died first
+    std::filesystem::create_directory(dir + "/snapshot.bin.tmp");
+    FlowGenerator generator(FlowConfig{.seed = 17});
+    std::uint64_t accepted = 0;
+    while (accepted < 3500) accepted += recorder.apply(generator.next());
+    EXPECT_THROW(recorder.flush(), std::runtime_error);
+    EXPECT_EQ(recorder.generation(), 3u);
+    EXPECT_EQ(read_snapshot_header(dir + "/snapshot.bin")->generation, 0u);
+
+    // The first snapshot, then journals 0 to 3 with each rollover command
+    Book recovered;
+    RecoveryStats stats = BookRecorder<Book>::recover(recovered, dir);
+    EXPECT_EQ(stats.replayed_messages, accepted);
+    expect_same_book(book, recovered);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BookRecorderTest, RecordingResumesAfterRecovery) {
+    std::string dir = temp_dir("lob_recorder_resume");
+    FlowGenerator generator(FlowConfig{.seed = 9});
+    Book original;
+    {
+        BookRecorder recorder(original, dir);
+        for (int i = 0; i < 5000; ++i) recorder.apply(generator.next());
+    }
+
+    Book restarted;
+    BookRecorder<Book>::recover(restarted, dir);
+    expect_same_book(original, restarted);
+    {
+        BookRecorder recorder(restarted, dir);
+        EXPECT_EQ(recorder.generation(), 1u);
+        for (int i = 0; i < 5000; ++i) {
+            OrderCommand command = generator.next();
+            apply(original, command);
+            recorder.apply(command);
+        }
+    }
+
+    Book recovered;
+    BookRecorder<Book>::recover(recovered, dir);
+    expect_same_book(original, recovered);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BookRecorderTest, PeriodicSnapshotsAreWrittenInTheBackground) {
+    std::string dir = temp_dir("lob_recorder_background");
+    Book book;
+    BookRecorder recorder(book, dir, RecorderConfig{.snapshot_interval = 1000});
+    FlowGenerator generator(FlowConfig{.seed = 13});
+    for (int i = 0; i < 10'000; ++i) recorder.apply(generator.next());
+    recorder.flush();
+
+    // Skipped intervals are fine; some snapshot past the first must be in
+    auto header = read_snapshot_header(dir + "/snapshot.bin");
+    ASSERT_TRUE(header);
+    EXPECT_GT(header->journal_count, 0u);
+    EXPECT_LE(header->journal_count, recorder.journal().count());
+    EXPECT_FALSE(std::filesystem::exists(dir + "/snapshot.bin.tmp"));
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BookRecorderTest, WriterFailureIsRethrownOnTheCallingThread) {
+    std::string dir = temp_dir("lob_recorder_failure");
+    Book book;
+    BookRecorder recorder(book, dir);
+    recorder.flush();
+
+    // The mapped journal keeps working; the next snapshot can't be created
+    std::filesystem::remove_all(dir);
+    recorder.snapshot();
+    EXPECT_THROW(recorder.flush(), std::runtime_error);
+    EXPECT_NO_THROW(recorder.flush());
+}
+
+TEST(BookRecorderTest, CrossedBuilderBookRecoversUnchanged) {
+    std::string dir = temp_dir("lob_recorder_crossed");
+    Book book;
+    ASSERT_TRUE(book.insert_order({1, Side::SELL, 10, 100}));
+    ASSERT_TRUE(book.insert_order({2, Side::BUY, 5, 101}));
+    ASSERT_TRUE(book.insert_order({3, Side::SELL, 7, 99}));
+    ASSERT_TRUE(book.insert_order({4, Side::BUY, 20, 98, OrderType::LIMIT, 5}));
+    ASSERT_TRUE(book.add_order({5, Side::SELL, 3, 97, OrderType::STOP_LIMIT, 0, 96}));
+    {
+        BookRecorder recorder(book, dir);
+        recorder.flush();
+    }
+
+    Book recovered;
+    RecoveryStats stats = BookRecorder<Book>::recover(recovered, dir);
+    EXPECT_EQ(stats.restored_orders, 5u);
+    expect_same_book(book, recovered);
+    EXPECT_EQ(recovered.best_bid(), 101);
+    EXPECT_EQ(recovered.best_ask(), 99);
+    EXPECT_EQ(recovered.order_count(), 4u);
+    EXPECT_EQ(recovered.pending_stops(), 1u);
+    EXPECT_EQ(recovered.volume_at(Side::BUY, 98), 5);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BookRecorderTest, IcebergSliceSurvivesSnapshotAndReplay) {
+    std::string dir = temp_dir("lob_recorder_iceberg");
+    Book book;
+    {
+        BookRecorder recorder(book, dir);
+        recorder.apply({.id = 1, .quantity = 100, .price = 1000, .side = Side::SELL, .display_quantity = 10});
+        recorder.apply({.id = 2, .quantity = 10, .price = 1000, .side = Side::SELL});
+        recorder.apply({.id = 3, .quantity = 3, .price = 1000, .side = Side::BUY});
+
+        // Taken with 7 of the iceberg's slice showing, ahead of order 2
+        recorder.snapshot();
+        recorder.apply({.id = 4, .quantity = 10, .price = 1000, .side = Side::BUY});
+        recorder.flush();
+    }
+
+    Book recovered;
+    RecoveryStats stats = BookRecorder<Book>::recover(recovered, dir);
+    EXPECT_EQ(stats.restored_orders, 2u);
+    EXPECT_EQ(stats.replayed_messages, 1u);
+    expect_same_book(book, recovered);
+
+    // The tail used up the slice, so the iceberg requeued behind order 2
+    auto orders = resting_orders(recovered);
+    ASSERT_EQ(orders.size(), 2u);
+    EXPECT_EQ(orders[0].id, 2u);
+    EXPECT_EQ(orders[0].quantity, 7);
+    EXPECT_EQ(orders[1].id, 1u);
+    EXPECT_EQ(orders[1].quantity, 90);
+    EXPECT_EQ(orders[1].visible, 10);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(BookRecorderTest, EmptyDirectoryRecoversEmptyBook) {
+    std::string dir = temp_dir("lob_recorder_empty");
+    Book book;
+    RecoveryStats stats = BookRecorder<Book>::recover(book, dir);
+    EXPECT_EQ(stats.restored_orders, 0u);
+    EXPECT_EQ(book.order_count(), 0u);
+}
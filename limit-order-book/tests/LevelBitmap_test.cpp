@@ -0,0 +1,49 @@
+#include <gtest/gtest.h>
+#include "LevelBitmap.h"
+
+TEST(LevelBitmapTest, EmptyFindsNothing) {
+    LevelBitmap bitmap(1024);
+    EXPECT_EQ(bitmap.find_next(0), LevelBitmap::npos);
+    EXPECT_EQ(bitmap.find_prev(1023), LevelBitmap::npos);
+}
+
+TEST(LevelBitmapTest, FindsWithinOneWord) {
+    LevelBitmap bitmap(64);
+    bitmap.set(3);
+    bitmap.set(40);
+
+    EXPECT_EQ(bitmap.find_next(0), 3u);
+    EXPECT_EQ(bitmap.find_next(4), 40u);
+    EXPECT_EQ(bitmap.find_next(41), LevelBitmap::npos);
+    EXPECT_EQ(bitmap.find_prev(63), 40u);
+    EXPECT_EQ(bitmap.find_prev(39), 3u);
+    EXPECT_EQ(bitmap.find_prev(2), LevelBitmap::npos);
+}
+
+TEST(LevelBitmapTest, FindsAcrossWordsAndLayers) {
+    // 2^18 slots: three layers
+    LevelBitmap bitmap(1 << 18);
+    bitmap.set(5);
+    bitmap.set(70'000);
+    bitmap.set((1 << 18) - 1);
+
+    EXPECT_EQ(bitmap.find_next(6), 70'000u);
+    EXPECT_EQ(bitmap.find_next(70'001), (1u << 18) - 1);
+    EXPECT_EQ(bitmap.find_prev(69'999), 5u);
+    EXPECT_EQ(bitmap.find_prev((1 << 18) - 2), 70'000u);
+}
+
+TEST(LevelBitmapTest, ClearPropagatesUpward) {
+    LevelBitmap bitmap(1 << 14);
+    bitmap.set(100);
+    bitmap.set(101);
+    bitmap.set(9'000);
+
+    bitmap.clear(100);
+    EXPECT_TRUE(bitmap.test(101));
+    EXPECT_EQ(bitmap.find_next(0), 101u);
+
+    bitmap.clear(101);
+    EXPECT_EQ(bitmap.find_next(0), 9'000u);
+    EXPECT_EQ(bitmap.find_prev(8'999), LevelBitmap::npos);
+}
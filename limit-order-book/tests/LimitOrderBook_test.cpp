@@ -0,0 +1,533 @@
+#include <gtest/gtest.h>
+#include "FeedSink.h"
+#include "FlowGenerator.h"
+#include "LimitOrderBook.h"
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Every behaviour must hold for each level-store backend
+template <typename Book>
+class LimitOrderBookTest : public ::testing::Test {};
+
+using Backends = ::testing::Types<LimitOrderBook<MapLevels>, LimitOrderBook<PriceLadder>,
+                                  LimitOrderBook<PriceLadder, NullSink, WidePrices>>;
+TYPED_TEST_SUITE(LimitOrderBookTest, Backends);
+
+TYPED_TEST(LimitOrderBookTest, RestsNonCrossingOrders) {
+    TypeParam book;
+    EXPECT_TRUE(book.add_order({1, Side::BUY, 10, 99}));
+    EXPECT_TRUE(book.add_order({2, Side::SELL, 5, 101}));
+
+    EXPECT_EQ(book.best_bid(), 99);
+    EXPECT_EQ(book.best_ask(), 101);
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 10);
+    EXPECT_EQ(book.volume_at(Side::SELL, 101), 5);
+    EXPECT_EQ(book.order_count(), 2u);
+}
+
+TYPED_TEST(LimitOrderBookTest, RejectsDuplicateIdAndEmptyQuantity) {
+    TypeParam book;
+    EXPECT_TRUE(book.add_order({1, Side::BUY, 10, 99}));
+    EXPECT_FALSE(book.add_order({1, Side::BUY, 10, 98}));
+    EXPECT_FALSE(book.add_order({2, Side::SELL, 0, 101}));
+
+    EXPECT_EQ(book.order_count(), 1u);
+    EXPECT_EQ(book.volume_at(Side::BUY, 98), 0);
+}
+
+TYPED_TEST(LimitOrderBookTest, FillsInPriceThenTimePriority) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 10, 101});
+    book.add_order({2, Side::SELL, 10, 100});
+    book.add_order({3, Side::SELL, 10, 100});
+
+    // Takes all of #2, half of #3, never reaches 101
+    book.add_order({4, Side::BUY, 15, 100});
+
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 5);
+    EXPECT_EQ(book.queue_position(2), std::nullopt);
+    EXPECT_EQ(book.queue_position(3), 0u);
+    EXPECT_EQ(book.volume_at(Side::SELL, 101), 10);
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+}
+
+TYPED_TEST(LimitOrderBookTest, SweepsLevelsAndRestsRemainder) {
+    TypeParam book;
+    book.add_order({1, Side::BUY, 10, 99});
+    book.add_order({2, Side::BUY, 10, 98});
+
+    book.add_order({3, Side::SELL, 25, 98});
+
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+    EXPECT_EQ(book.best_ask(), 98);
+    EXPECT_EQ(book.volume_at(Side::SELL, 98), 5);
+    EXPECT_EQ(book.order_count(), 1u);
+}
+
+TYPED_TEST(LimitOrderBookTest, CancelRemovesOrderAndEmptyLevel) {
+    TypeParam book;
+    book.add_order({1, Side::BUY, 10, 99});
+    book.add_order({2, Side::BUY, 20, 99});
+    book.add_order({3, Side::BUY, 30, 98});
+
+    EXPECT_TRUE(book.cancel_order(1));
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 20);
+    EXPECT_EQ(book.queue_position(2), 0u);
+
+    EXPECT_TRUE(book.cancel_order(2));
+    EXPECT_EQ(book.best_bid(), 98);
+
+    EXPECT_FALSE(book.cancel_order(2));
+    EXPECT_FALSE(book.cancel_order(42));
+}
+
+TYPED_TEST(LimitOrderBookTest, ModifyDownKeepsPriorityUpLosesIt) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 10, 100});
+    book.add_order({2, Side::SELL, 10, 100});
+
+    EXPECT_TRUE(book.modify_order(1, 4));
+    EXPECT_EQ(book.queue_position(1), 0u);
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 14);
+
+    EXPECT_TRUE(book.modify_order(1, 8));
+    EXPECT_EQ(book.queue_position(1), 1u);
+    EXPECT_EQ(book.queue_position(2), 0u);
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 18);
+
+    // #2 is now first in line
+    book.add_order({3, Side::BUY, 10, 100});
+    EXPECT_EQ(book.queue_position(2), std::nullopt);
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 8);
+}
+
+TYPED_TEST(LimitOrderBookTest, ModifyToZeroCancels) {
+    TypeParam book;
+    book.add_order({1, Side::BUY, 10, 99});
+
+    EXPECT_TRUE(book.modify_order(1, 0));
+    EXPECT_EQ(book.order_count(), 0u);
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+    EXPECT_FALSE(book.modify_order(1, 5));
+}
+
+TYPED_TEST(LimitOrderBookTest, ExecuteFillsRestingOrderInPlace) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 10, 100});
+    book.add_order({2, Side::SELL, 10, 100});
+
+    EXPECT_TRUE(book.execute_order(2, 4));
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 16);
+    EXPECT_EQ(book.queue_position(2), 1u);
+
+    EXPECT_TRUE(book.execute_order(1, 50));
+    EXPECT_EQ(book.queue_position(1), std::nullopt);
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 6);
+    EXPECT_FALSE(book.execute_order(1, 1));
+}
+
+TYPED_TEST(LimitOrderBookTest, IocTradesWhatItCanAndNeverRests) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 10, 100});
+    book.add_order({2, Side::SELL, 10, 102});
+
+    EXPECT_TRUE(book.add_order({3, Side::BUY, 15, 101, OrderType::IOC}));
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 0);
+    EXPECT_EQ(book.volume_at(Side::SELL, 102), 10);
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+    EXPECT_EQ(book.queue_position(3), std::nullopt);
+}
+
+TYPED_TEST(LimitOrderBookTest, FokFillsCompletelyOrNotAtAll) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 10, 100});
+    book.add_order({2, Side::SELL, 10, 101});
+    book.add_order({3, Side::SELL, 10, 103});
+
+    // 20 reachable through 102: killed, book untouched
+    EXPECT_TRUE(book.add_order({4, Side::BUY, 25, 102, OrderType::FOK}));
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 10);
+    EXPECT_EQ(book.volume_at(Side::SELL, 101), 10);
+    EXPECT_EQ(book.order_count(), 3u);
+
+    EXPECT_TRUE(book.add_order({5, Side::BUY, 25, 103, OrderType::FOK}));
+    EXPECT_EQ(book.best_ask(), 103);
+    EXPECT_EQ(book.volume_at(Side::SELL, 103), 5);
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+
+    // Same on the bid side
+    book.add_order({6, Side::BUY, 10, 99});
+    book.add_order({7, Side::BUY, 10, 98});
+    EXPECT_TRUE(book.add_order({8, Side::SELL, 21, 98, OrderType::FOK}));
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 10);
+    EXPECT_TRUE(book.add_order({9, Side::SELL, 20, 98, OrderType::FOK}));
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+    EXPECT_EQ(book.best_ask(), 103);
+}
+
+TYPED_TEST(LimitOrderBookTest, MarketOrderSweepsAnyPriceAndExpiresRemainder) {
+    TypeParam book;
+    book.add_order({1, Side::BUY, 10, 99});
+    book.add_order({2, Side::BUY, 10, 50});
+
+    // The price of a market order is ignored, on tick or not
+    EXPECT_TRUE(book.add_order({3, Side::SELL, 30, 7, OrderType::MARKET}));
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+    EXPECT_EQ(book.best_ask(), std::nullopt);
+    EXPECT_EQ(book.order_count(), 0u);
+}
+
+TYPED_TEST(LimitOrderBookTest, IcebergShowsPeakAndRequeuesEachSlice) {
+    TypeParam book;
+    EXPECT_TRUE(book.add_order({1, Side::SELL, 25, 100, OrderType::LIMIT, 10}));
+    book.add_order({2, Side::SELL, 5, 100});
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 15);
+
+    // Uses up the first slice; the next one goes behind #2
+    book.add_order({3, Side::BUY, 10, 100});
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 15);
+    EXPECT_EQ(book.queue_position(2), 0u);
+    EXPECT_EQ(book.queue_position(1), 1u);
+
+    // Hidden quantity is reachable by aggressors and counts toward a FOK
+    EXPECT_TRUE(book.add_order({4, Side::BUY, 19, 100, OrderType::FOK}));
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 1);
+    EXPECT_EQ(book.queue_position(1), 0u);
+
+    EXPECT_TRUE(book.add_order({5, Side::BUY, 2, 100, OrderType::FOK}));
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 1);
+    EXPECT_TRUE(book.add_order({6, Side::BUY, 1, 100}));
+    EXPECT_EQ(book.best_ask(), std::nullopt);
+    EXPECT_EQ(book.order_count(), 0u);
+}
+
+TYPED_TEST(LimitOrderBookTest, IcebergModifyTakesReserveFirst) {
+    TypeParam book;
+    book.add_order({1, Side::BUY, 30, 99, OrderType::LIMIT, 10});
+    book.add_order({2, Side::BUY, 5, 99});
+
+    // 30 -> 12 leaves the visible 10 in place with 2 behind it
+    EXPECT_TRUE(book.modify_order(1, 12));
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 15);
+    EXPECT_EQ(book.queue_position(1), 0u);
+    EXPECT_TRUE(book.execute_order(1, 10));
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 7);
+    EXPECT_EQ(book.queue_position(1), 1u);
+
+    // Growing goes to the back with a fresh peak
+    EXPECT_TRUE(book.modify_order(1, 40));
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 15);
+    EXPECT_TRUE(book.cancel_order(1));
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 5);
+}
+
+TYPED_TEST(LimitOrderBookTest, RejectsNegativeDisplayQuantity) {
+    TypeParam book;
+    EXPECT_FALSE(book.add_order({1, Side::BUY, 10, 99, OrderType::LIMIT, -1}));
+    EXPECT_EQ(book.order_count(), 0u);
+}
+
+TYPED_TEST(LimitOrderBookTest, StopTriggersOnTradeThroughItsPrice) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 10, 100});
+    book.add_order({2, Side::SELL, 10, 101});
+    book.add_order({3, Side::SELL, 10, 102});
+
+    EXPECT_TRUE(book.add_order({4, Side::BUY, 5, 0, OrderType::STOP, 0, 101}));
+    EXPECT_EQ(book.pending_stops(), 1u);
+    EXPECT_EQ(book.order_count(), 3u);
+
+    // A trade at 100 is below the trigger
+    book.add_order({5, Side::BUY, 10, 100});
+    EXPECT_EQ(book.pending_stops(), 1u);
+
+    // A trade at 101 triggers it as a market order
+    book.add_order({6, Side::BUY, 5, 101});
+    EXPECT_EQ(book.pending_stops(), 0u);
+    EXPECT_EQ(book.volume_at(Side::SELL, 101), 0);
+    EXPECT_EQ(book.volume_at(Side::SELL, 102), 10);
+    EXPECT_EQ(book.queue_position(4), std::nullopt);
+}
+
+TYPED_TEST(LimitOrderBookTest, StopLimitRestsAtItsLimitOnceTriggered) {
+    TypeParam book;
+    book.add_order({1, Side::BUY, 10, 99});
+    book.add_order({2, Side::BUY, 10, 97});
+    book.add_order({3, Side::SELL, 20, 100, OrderType::STOP_LIMIT, 0, 99});
+
+    book.add_order({4, Side::SELL, 10, 99});
+    EXPECT_EQ(book.pending_stops(), 0u);
+    EXPECT_EQ(book.best_bid(), 97);
+    EXPECT_EQ(book.best_ask(), 100);
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 20);
+}
+
+TYPED_TEST(LimitOrderBookTest, TriggeredStopsEnterInTriggerThenTimeOrder) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 10, 100});
+    book.add_order({2, Side::SELL, 10, 101});
+
+    // Stop-limits priced to rest far below, so the queue at 90 shows entry order
+    book.add_order({10, Side::BUY, 1, 90, OrderType::STOP_LIMIT, 0, 101});
+    book.add_order({11, Side::BUY, 1, 90, OrderType::STOP_LIMIT, 0, 100});
+    book.add_order({12, Side::BUY, 1, 90, OrderType::STOP_LIMIT, 0, 100});
+    book.add_order({13, Side::BUY, 1, 90, OrderType::STOP_LIMIT, 0, 102});
+
+    book.add_order({20, Side::BUY, 20, 101});
+    EXPECT_EQ(book.pending_stops(), 1u);
+    EXPECT_EQ(book.queue_position(11), 0u);
+    EXPECT_EQ(book.queue_position(12), 1u);
+    EXPECT_EQ(book.queue_position(10), 2u);
+    EXPECT_EQ(book.volume_at(Side::BUY, 90), 3);
+}
+
+TYPED_TEST(LimitOrderBookTest, TriggeredStopsCascade) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 5, 100});
+    book.add_order({2, Side::SELL, 5, 102});
+    book.add_order({3, Side::SELL, 5, 104});
+
+    // Each stop's fill is the trade that reaches the next one
+    book.add_order({10, Side::BUY, 5, 0, OrderType::STOP, 0, 100});
+    book.add_order({11, Side::BUY, 5, 0, OrderType::STOP, 0, 102});
+
+    book.add_order({20, Side::BUY, 5, 100});
+    EXPECT_EQ(book.pending_stops(), 0u);
+    EXPECT_EQ(book.best_ask(), std::nullopt);
+}
+
+TYPED_TEST(LimitOrderBookTest, StopsIgnoreTradesBeforeThemAndCanBeCancelled) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 10, 100});
+    book.add_order({2, Side::BUY, 5, 100});
+
+    book.add_order({3, Side::BUY, 5, 105, OrderType::STOP_LIMIT, 0, 100});
+    book.add_order({4, Side::BUY, 1, 95});
+    EXPECT_EQ(book.pending_stops(), 1u);
+    EXPECT_FALSE(book.execute_order(3, 1));
+
+    EXPECT_TRUE(book.modify_order(3, 2));
+    EXPECT_TRUE(book.cancel_order(3));
+    EXPECT_EQ(book.pending_stops(), 0u);
+    EXPECT_FALSE(book.cancel_order(3));
+
+    // A stop reusing a live id is refused
+    EXPECT_FALSE(book.add_order({4, Side::SELL, 1, 0, OrderType::STOP, 0, 90}));
+    book.add_order({5, Side::SELL, 1, 0, OrderType::STOP, 0, 90});
+    book.add_order({6, Side::SELL, 1, 100});
+    EXPECT_EQ(book.pending_stops(), 1u);
+}
+
+TYPED_TEST(LimitOrderBookTest, ExecutePrintTriggersStops) {
+    TypeParam book;
+    book.add_order({1, Side::BUY, 10, 99});
+    book.add_order({2, Side::SELL, 4, 0, OrderType::STOP, 0, 99});
+
+    EXPECT_TRUE(book.execute_order(1, 1));
+    EXPECT_EQ(book.pending_stops(), 0u);
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 5);
+}
+
+TYPED_TEST(LimitOrderBookTest, ForEachOrderRebuildsPendingStops) {
+    using BookOrder = typename TypeParam::Order;
+    TypeParam book;
+    book.add_order({1, Side::BUY, 10, 99});
+    book.add_order({2, Side::SELL, 30, 101, OrderType::LIMIT, 10});
+    book.add_order({3, Side::BUY, 5, 103, OrderType::STOP_LIMIT, 0, 102});
+    book.add_order({4, Side::SELL, 5, 0, OrderType::STOP, 0, 99});
+
+    std::vector<BookOrder> orders;
+    book.for_each_order([&](const BookOrder& order) { orders.push_back(order); });
+    TypeParam copy;
+    copy.add_orders(orders);
+
+    EXPECT_EQ(copy.order_count(), 2u);
+    EXPECT_EQ(copy.pending_stops(), 2u);
+    EXPECT_EQ(copy.volume_at(Side::SELL, 101), 10);
+
+    // Both books trigger the same way
+    for (TypeParam* b : {&book, &copy}) {
+        b->add_order({5, Side::SELL, 10, 99});
+        EXPECT_EQ(b->pending_stops(), 1u);
+        EXPECT_EQ(b->best_bid(), std::nullopt);
+    }
+}
+
+TYPED_TEST(LimitOrderBookTest, InsertOrderRestsWithoutCrossing) {
+    TypeParam book;
+    EXPECT_TRUE(book.insert_order({1, Side::SELL, 10, 100}));
+    EXPECT_TRUE(book.insert_order({2, Side::BUY, 5, 101}));
+
+    // A crossed feed stays crossed
+    EXPECT_EQ(book.best_bid(), 101);
+    EXPECT_EQ(book.best_ask(), 100);
+    EXPECT_EQ(book.order_count(), 2u);
+
+    EXPECT_FALSE(book.insert_order({1, Side::BUY, 5, 99}));
+    EXPECT_FALSE(book.insert_order({3, Side::BUY, 0, 99}));
+    EXPECT_FALSE(book.insert_order({4, Side::BUY, 5, 99, OrderType::IOC}));
+
+    EXPECT_TRUE(book.execute_order(1, 4));
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 6);
+    EXPECT_TRUE(book.cancel_order(2));
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+}
+
+TYPED_TEST(LimitOrderBookTest, RestoreOrdersRebuildsWithoutMatchingOrTriggering) {
+    using RestingOrder = typename TypeParam::RestingOrder;
+    std::vector<RestingOrder> orders{
+        {{1, Side::SELL, 10, 100}},
+        {{2, Side::BUY, 5, 101}},                                 // Crosses 1
+        {{3, Side::BUY, 20, 99, OrderType::LIMIT, 5}, 2},         // Iceberg part-way through a slice
+        {{4, Side::BUY, 4, 102, OrderType::STOP_LIMIT, 0, 100}},  // Already through its trigger
+        {{5, Side::BUY, 1, 98, OrderType::IOC}},
+    };
+
+    TypeParam book;
+    EXPECT_EQ(book.restore_orders(orders), 4u);
+    EXPECT_EQ(book.best_bid(), 101);
+    EXPECT_EQ(book.best_ask(), 100);
+    EXPECT_EQ(book.volume_at(Side::SELL, 100), 10);
+    EXPECT_EQ(book.volume_at(Side::BUY, 99), 2);
+    EXPECT_EQ(book.order_count(), 3u);
+    EXPECT_EQ(book.pending_stops(), 1u);
+    EXPECT_EQ(book.top_of_book().load().bid_price, 101);
+}
+
+template <typename Book>
+std::vector<typename Book::Order> resting_orders(const Book& book) {
+    std::vector<typename Book::Order> orders;
+    book.for_each_order([&](const typename Book::Order& order) { orders.push_back(order); });
+    return orders;
+}
+
+template <typename Builder>
+void expect_feed_rebuilds_matched_book() {
+    std::vector<OrderCommand> feed;
+    LimitOrderBook<PriceLadder, FeedSink> matcher({}, FeedSink(feed));
+    FlowGenerator generator(FlowConfig{.seed = 21});
+    for (int i = 0; i < 50'000; ++i) apply(matcher, generator.next());
+
+    Builder builder;
+    for (const OrderCommand& command : feed) ASSERT_TRUE(apply_feed(builder, command));
+
+    auto expected = resting_orders(matcher);
+    auto rebuilt = resting_orders(builder);
+    ASSERT_EQ(rebuilt.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(rebuilt[i].id, expected[i].id);
+        EXPECT_EQ(rebuilt[i].quantity, expected[i].quantity);
+        EXPECT_EQ(rebuilt[i].price, expected[i].price);
+    }
+    EXPECT_EQ(builder.best_bid(), matcher.best_bid());
+    EXPECT_EQ(builder.best_ask(), matcher.best_ask());
+    EXPECT_DOUBLE_EQ(builder.analytics().microprice, matcher.analytics().microprice);
+}
+
+TEST(BuilderModeTest, FeedOfMatchedFlowRebuildsTheBook) {
+    expect_feed_rebuilds_matched_book<LimitOrderBook<MapLevels>>();
+    expect_feed_rebuilds_matched_book<LimitOrderBook<PriceLadder>>();
+}
+
+template <template <Side, typename> class Levels>
+void expect_widely_spaced_fok() {
+    // A dense FOK index or ladder would need gigabytes to span these prices
+    LimitOrderBook<Levels> book;
+    book.add_order({1, Side::SELL, 10, 100});
+    book.add_order({2, Side::SELL, 10, 100'000'000});
+    book.add_order({3, Side::SELL, 5, 2'000'000'000});
+    book.add_order({4, Side::BUY, 10, -2'000'000'000});
+    book.add_order({5, Side::BUY, 10, 1});
+
+    EXPECT_TRUE(book.add_order({6, Side::BUY, 30, 100'000'000, OrderType::FOK}));
+    EXPECT_EQ(book.order_count(), 5u);
+    EXPECT_TRUE(book.add_order({7, Side::BUY, 25, 2'000'000'000, OrderType::FOK}));
+    EXPECT_EQ(book.best_ask(), std::nullopt);
+
+    EXPECT_TRUE(book.add_order({8, Side::SELL, 21, -2'000'000'000, OrderType::FOK}));
+    EXPECT_EQ(book.volume_at(Side::BUY, 1), 10);
+    EXPECT_TRUE(book.add_order({9, Side::SELL, 20, -2'000'000'000, OrderType::FOK}));
+    EXPECT_EQ(book.best_bid(), std::nullopt);
+    EXPECT_EQ(book.heap_allocations(), 0u);
+}
+
+TEST(FokTest, WidelySpacedLevelsDoNotFillTheGap) {
+    expect_widely_spaced_fok<MapLevels>();
+    expect_widely_spaced_fok<PriceLadder>();
+}
+
+template <template <Side, typename> class Levels>
+void expect_tick_of_five() {
+    LimitOrderBook<Levels, NullSink, PriceTraits<int, int, 5>> book;
+    EXPECT_FALSE(book.add_order({1, Side::BUY, 10, 99}));
+    EXPECT_TRUE(book.add_order({2, Side::BUY, 10, 95}));
+    EXPECT_EQ(book.best_bid(), 95);
+}
+
+TEST(PriceTraitsTest, RejectsOffTickPrices) {
+    expect_tick_of_five<MapLevels>();
+    expect_tick_of_five<PriceLadder>();
+}
+
+TEST(PriceTraitsTest, WidePricesHoldNotionalsBeyondInt) {
+    // Cents with a 5-cent tick: 60 million dollars a share
+    using Cents = PriceTraits<std::int64_t, std::int64_t, 5, 100>;
+    LimitOrderBook<PriceLadder, NullSink, Cents> book;
+    const std::int64_t price = Cents::from_double(60'000'000.05);
+    const std::int64_t size = 3'000'000'000;
+
+    EXPECT_TRUE(book.add_order({1, Side::SELL, size, price}));
+    EXPECT_FALSE(book.add_order({2, Side::SELL, 1, price + 1}));
+    EXPECT_TRUE(book.add_order({3, Side::BUY, size - 1, price + Cents::tick_size}));
+
+    EXPECT_EQ(book.volume_at(Side::SELL, price), 1);
+    EXPECT_EQ(book.best_ask(), price);
+    EXPECT_DOUBLE_EQ(Cents::to_double(*book.best_ask()), 60'000'000.05);
+}
+
+TYPED_TEST(LimitOrderBookTest, AddOrdersMatchesOneAtATime) {
+    using BookOrder = typename TypeParam::Order;
+    std::vector<BookOrder> orders;
+    for (int i = 0; i < 2'000; ++i) {
+        // Mostly passive around 100 with every seventh order crossing
+        bool buy = i % 2;
+        int offset = i % 7 == 0 ? -3 : 1 + i % 5;
+        int price = buy ? 100 - offset : 100 + offset;
+        orders.push_back({static_cast<OrderId>(i + 1), buy ? Side::BUY : Side::SELL, 1 + i % 9, price});
+        if (i % 11 == 0) {
+            orders.back().type = static_cast<OrderType>(1 + i / 11 % 5);
+            orders.back().stop_price = buy ? 100 + i % 3 : 100 - i % 3;
+        }
+        else if (i % 13 == 0) {
+            orders.back().display_quantity = 2;
+        }
+    }
+    orders.push_back({5, Side::BUY, 1, 90});   // Duplicate id
+    orders.push_back({9'999, Side::SELL, 0, 100});  // Bad quantity
+
+    TypeParam single;
+    std::size_t accepted_single = 0;
+    for (const BookOrder& order : orders) accepted_single += single.add_order(order);
+
+    TypeParam batched;
+    std::size_t accepted = 0;
+    for (std::size_t i = 0; i < orders.size(); i += 64) {
+        std::size_t n = std::min<std::size_t>(64, orders.size() - i);
+        accepted += batched.add_orders(std::span<const BookOrder>(orders).subspan(i, n));
+    }
+
+    EXPECT_EQ(accepted, accepted_single);
+    EXPECT_EQ(batched.order_count(), single.order_count());
+    EXPECT_EQ(batched.pending_stops(), single.pending_stops());
+    EXPECT_EQ(batched.best_bid(), single.best_bid());
+    EXPECT_EQ(batched.best_ask(), single.best_ask());
+    for (int price = 90; price <= 110; ++price) {
+        EXPECT_EQ(batched.volume_at(Side::BUY, price), single.volume_at(Side::BUY, price));
+        EXPECT_EQ(batched.volume_at(Side::SELL, price), single.volume_at(Side::SELL, price));
+    }
+    for (OrderId id = 1; id <= orders.size(); ++id) {
+        EXPECT_EQ(batched.queue_position(id), single.queue_position(id));
+    }
+}
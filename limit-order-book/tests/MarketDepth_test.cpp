@@ -0,0 +1,224 @@
+#include <gtest/gtest.h>
+#include "LimitOrderBook.h"
+#include "FlowGenerator.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+template <typename Book>
+class MarketDepthTest : public ::testing::Test {};
+
+using Backends = ::testing::Types<LimitOrderBook<MapLevels>, LimitOrderBook<PriceLadder>>;
+TYPED_TEST_SUITE(MarketDepthTest, Backends);
+
+namespace {
+
+// Consumer-side replica built only from deltas
+struct DepthReplica {
+    std::map<int, DepthLevel> bids;
+    std::map<int, DepthLevel> asks;
+
+    void apply(const DepthDelta& delta) {
+        for (std::size_t k = 0; k < delta.count; ++k) {
+            const DepthUpdate& update = delta.updates[k];
+            auto& side = update.side == Side::BUY ? bids : asks;
+            if (update.level.quantity == 0) side.erase(update.level.price);
+            else side[update.level.price] = update.level;
+        }
+    }
+
+    void reset(const DepthSnapshot& snapshot) {
+        bids.clear();
+        asks.clear();
+        for (std::size_t i = 0; i < snapshot.bid_count; ++i) bids[snapshot.bids[i].price] = snapshot.bids[i];
+        for (std::size_t i = 0; i < snapshot.ask_count; ++i) asks[snapshot.asks[i].price] = snapshot.asks[i];
+    }
+};
+
+}
+
+TYPED_TEST(MarketDepthTest, TracksLevelsBestFirst) {
+    TypeParam book;
+    book.add_order({1, Side::BUY, 10, 99});
+    book.add_order({2, Side::BUY, 5, 100});
+    book.add_order({3, Side::BUY, 7, 100});
+    book.add_order({4, Side::SELL, 8, 102});
+
+    const DepthSnapshot& depth = book.depth();
+    ASSERT_EQ(depth.bid_count, 2);
+    EXPECT_EQ(depth.bids[0].price, 100);
+    EXPECT_EQ(depth.bids[0].quantity, 12);
+    EXPECT_EQ(depth.bids[0].order_count, 2u);
+    EXPECT_EQ(depth.bids[1].price, 99);
+    ASSERT_EQ(depth.ask_count, 1);
+    EXPECT_EQ(depth.asks[0].price, 102);
+    EXPECT_EQ(depth.sequence, 4u);
+}
+
+TYPED_TEST(MarketDepthTest, DeltaListsOnlyChangedLevels) {
+    TypeParam book;
+    book.add_order({1, Side::SELL, 5, 101});
+    book.add_order({2, Side::SELL, 5, 102});
+    book.add_order({3, Side::SELL, 5, 103});
+    book.add_order({4, Side::BUY, 5, 99});
+
+    // Sweep 101 fully and 102 partially, rest nothing
+    book.add_order({5, Side::BUY, 8, 102});
+    const DepthDelta& delta = book.depth_delta();
+    ASSERT_EQ(delta.count, 2);
+    EXPECT_EQ(delta.updates[0].side, Side::SELL);
+    EXPECT_EQ(delta.updates[0].level.price, 101);
+    EXPECT_EQ(delta.updates[0].level.quantity, 0);
+    EXPECT_EQ(delta.updates[1].level.price, 102);
+    EXPECT_EQ(delta.updates[1].level.quantity, 2);
+    EXPECT_FALSE(delta.full_refresh);
+
+    // A rejected call publishes nothing
+    std::uint64_t sequence = book.depth().sequence;
+    EXPECT_FALSE(book.cancel_order(42));
+    EXPECT_EQ(book.depth_delta().count, 0);
+    EXPECT_EQ(book.depth().sequence, sequence);
+}
+
+TYPED_TEST(MarketDepthTest, RefillsFromBelowWhenALevelLeaves) {
+    TypeParam book;
+    for (int i = 0; i < 15; ++i) book.add_order({static_cast<OrderId>(i + 1), Side::BUY, 1, 100 - i});
+    ASSERT_EQ(book.depth().bid_count, DEPTH_LEVELS);
+    EXPECT_EQ(book.depth().bids[DEPTH_LEVELS - 1].price, 91);
+
+    // Changes below the view don't touch it
+    book.add_order({100, Side::BUY, 3, 88});
+    EXPECT_EQ(book.depth_delta().count, 0);
+
+    book.cancel_order(1);
+    const DepthSnapshot& depth = book.depth();
+    ASSERT_EQ(depth.bid_count, DEPTH_LEVELS);
+    EXPECT_EQ(depth.bids[0].price, 99);
+    EXPECT_EQ(depth.bids[DEPTH_LEVELS - 1].price, 90);
+
+    const DepthDelta& delta = book.depth_delta();
+    ASSERT_EQ(delta.count, 2);
+    EXPECT_EQ(delta.updates[0].level.price, 100);
+    EXPECT_EQ(delta.updates[0].level.quantity, 0);
+    EXPECT_EQ(delta.updates[1].level.price, 90);
+    EXPECT_EQ(delta.updates[1].level.quantity, 1);
+
+    // A new best pushes the worst level out of view
+    book.add_order({101, Side::BUY, 2, 100});
+    EXPECT_EQ(book.depth().bids[DEPTH_LEVELS - 1].price, 91);
+    ASSERT_EQ(book.depth_delta().count, 2);
+    EXPECT_EQ(book.depth_delta().updates[0].level.price, 90);
+    EXPECT_EQ(book.depth_delta().updates[0].level.quantity, 0);
+}
+
+TYPED_TEST(MarketDepthTest, DeepSweepFallsBackToFullRefresh) {
+    TypeParam book;
+    for (int i = 0; i < 100; ++i) book.add_order({static_cast<OrderId>(i + 1), Side::SELL, 1, 100 + i});
+
+    book.add_order({1000, Side::BUY, 60, 200});
+    EXPECT_TRUE(book.depth_delta().full_refresh);
+    EXPECT_EQ(book.depth().asks[0].price, 160);
+}
+
+TYPED_TEST(MarketDepthTest, MatchesBookAndReplicaUnderRandomFlow) {
+    TypeParam book;
+    FlowGenerator flow;
+    DepthReplica replica;
+    int lowest = 10'000, highest = 10'000;
+
+    auto check_side = [&](Side side, std::size_t count, const auto& levels, const auto& replicated) {
+        ASSERT_EQ(replicated.size(), count);
+        int best = side == Side::BUY ? highest : lowest;
+        int step = side == Side::BUY ? -1 : 1;
+        // Walk every price best to worst so skipped levels are caught too
+        std::size_t i = 0;
+        for (int price = best; price >= lowest && price <= highest; price += step) {
+            int volume = book.volume_at(side, price);
+            if (volume == 0) continue;
+            if (i < DEPTH_LEVELS) {
+                ASSERT_LT(i, count);
+                ASSERT_EQ(levels[i].price, price);
+                ASSERT_EQ(levels[i].quantity, volume);
+                ASSERT_EQ(replicated.at(price).quantity, volume);
+            }
+            ++i;
+        }
+        ASSERT_EQ(std::min(i, DEPTH_LEVELS), count);
+    };
+
+    for (int n = 0; n < 20'000; ++n) {
+        OrderCommand command = flow.next();
+        if (command.type == CommandType::ADD) {
+            lowest = std::min(lowest, command.price);
+            highest = std::max(highest, command.price);
+        }
+        apply(book, command);
+
+        const DepthDelta& delta = book.depth_delta();
+        if (delta.full_refresh) replica.reset(book.depth());
+        else replica.apply(delta);
+
+        const DepthSnapshot& depth = book.depth();
+        check_side(Side::BUY, depth.bid_count, depth.bids, replica.bids);
+        check_side(Side::SELL, depth.ask_count, depth.asks, replica.asks);
+        if (::testing::Test::HasFatalFailure()) FAIL() << "after message " << n;
+    }
+}
+
+TYPED_TEST(MarketDepthTest, AnalyticsFromTouchAndView) {
+    TypeParam book;
+    BookAnalytics empty = book.analytics();
+    EXPECT_EQ(empty.imbalance, 0.0);
+    EXPECT_TRUE(std::isnan(empty.microprice));
+
+    book.add_order({1, Side::BUY, 30, 99});
+    EXPECT_EQ(book.analytics().imbalance, 1.0);
+    EXPECT_TRUE(std::isnan(book.analytics().weighted_mid));
+
+    book.add_order({2, Side::BUY, 10, 98});
+    book.add_order({3, Side::SELL, 10, 101});
+    book.add_order({4, Side::SELL, 30, 104});
+
+    BookAnalytics a = book.analytics();
+    EXPECT_DOUBLE_EQ(a.imbalance, (30.0 - 10.0) / 40.0);
+    // Heavy bid pulls the microprice toward the ask
+    EXPECT_DOUBLE_EQ(a.microprice, (99.0 * 10 + 101.0 * 30) / 40.0);
+    double bid_vwap = (99.0 * 30 + 98.0 * 10) / 40.0;
+    double ask_vwap = (101.0 * 10 + 104.0 * 30) / 40.0;
+    EXPECT_DOUBLE_EQ(a.weighted_mid, (bid_vwap + ask_vwap) / 2);
+
+    // A trade through the touch updates them in place
+    book.add_order({5, Side::BUY, 10, 101});
+    a = book.analytics();
+    EXPECT_DOUBLE_EQ(a.microprice, (99.0 * 30 + 104.0 * 30) / 60.0);
+    EXPECT_DOUBLE_EQ(a.weighted_mid, (bid_vwap + 104.0) / 2);
+}
+
+TYPED_TEST(MarketDepthTest, AnalyticsMatchRecomputationUnderRandomFlow) {
+    TypeParam book;
+    FlowGenerator flow(FlowConfig{.seed = 17});
+
+    for (int n = 0; n < 20'000; ++n) {
+        apply(book, flow.next());
+
+        // Recompute from the published view
+        const DepthSnapshot& depth = book.depth();
+        if (!depth.bid_count || !depth.ask_count) continue;
+        auto vwap = [](const auto& levels, std::size_t count) {
+            double notional = 0, quantity = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                notional += static_cast<double>(levels[i].price) * levels[i].quantity;
+                quantity += levels[i].quantity;
+            }
+            return notional / quantity;
+        };
+        double bid = depth.bids[0].quantity;
+        double ask = depth.asks[0].quantity;
+
+        BookAnalytics a = book.analytics();
+        ASSERT_DOUBLE_EQ(a.imbalance, (bid - ask) / (bid + ask)) << "after message " << n;
+        ASSERT_DOUBLE_EQ(a.microprice, (depth.bids[0].price * ask + depth.asks[0].price * bid) / (bid + ask));
+        ASSERT_DOUBLE_EQ(a.weighted_mid, (vwap(depth.bids, depth.bid_count) + vwap(depth.asks, depth.ask_count)) / 2)
+            << "after message " << n;
+    }
+}
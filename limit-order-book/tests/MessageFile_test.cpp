@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "FlowGenerator.h"
+#include "LimitOrderBook.h"
+#include "MessageFile.h"
+#include <filesystem>
+#include <stdexcept>
+
+namespace {
+
+std::string temp_path(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+}
+
+TEST(MessageFileTest, RoundTripsRecordsThroughMapping) {
+    std::string path = temp_path("lob_message_file_test.bin");
+    FlowGenerator generator(FlowConfig{.num_symbols = 3, .seed = 7});
+    std::vector<OrderCommand> written;
+    {
+        MessageFileWriter writer(path, 3);
+        for (int i = 0; i < 1000; ++i) {
+            written.push_back(generator.next());
+            writer.write(written.back());
+        }
+    }
+
+    MappedMessageFile file(path);
+    ASSERT_EQ(file.messages().size(), written.size());
+    EXPECT_EQ(file.num_symbols(), 3u);
+    for (std::size_t i = 0; i < written.size(); ++i) {
+        EXPECT_EQ(file.messages()[i].id, written[i].id);
+        EXPECT_EQ(file.messages()[i].type, written[i].type);
+        EXPECT_EQ(file.messages()[i].price, written[i].price);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(MessageFileTest, RejectsForeignFile) {
+    std::string path = temp_path("lob_message_file_bad.bin");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << std::string(64, 'x');
+    }
+    EXPECT_THROW(MappedMessageFile{path}, std::runtime_error);
+    std::filesystem::remove(path);
+}
+
+TEST(FlowGeneratorTest, IsDeterministicAndMostlyAddsAndCancels) {
+    FlowGenerator a(FlowConfig{.seed = 1});
+    FlowGenerator b(FlowConfig{.seed = 1});
+
+    int adds = 0, cancels = 0;
+    for (int i = 0; i < 10'000; ++i) {
+        OrderCommand x = a.next();
+        OrderCommand y = b.next();
+        ASSERT_EQ(x.id, y.id);
+        ASSERT_EQ(x.type, y.type);
+        adds += x.type == CommandType::ADD;
+        cancels += x.type == CommandType::CANCEL;
+    }
+    EXPECT_GT(adds + cancels, 8'500);
+    EXPECT_GT(cancels, 3'500);
+}
+
+TEST(FlowGeneratorTest, ReplaysIntoBook) {
+    FlowGenerator generator;
+    LimitOrderBook<PriceLadder> book;
+    for (int i = 0; i < 50'000; ++i) apply(book, generator.next());
+
+    // Flow keeps a two-sided book around the mid
+    ASSERT_TRUE(book.best_bid().has_value());
+    ASSERT_TRUE(book.best_ask().has_value());
+    EXPECT_LT(*book.best_bid(), *book.best_ask());
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "OrderGateway.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+OrderCommand add(OrderId id, Side side, int quantity, int price) {
+    return {.id = id, .quantity = quantity, .price = price, .type = CommandType::ADD, .side = side};
+}
+
+OrderCommand cancel(OrderId id) {
+    return {.id = id, .type = CommandType::CANCEL};
+}
+
+}
+
+TEST(MpscRingTest, FifoAndBoundedForOneProducer) {
+    MpscRing<int> ring(4);
+    EXPECT_EQ(ring.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(ring.try_push(i));
+    EXPECT_FALSE(ring.try_push(4));
+
+    int value = -1;
+    ASSERT_TRUE(ring.try_pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.try_push(4));
+
+    std::vector<int> drained;
+    EXPECT_EQ(ring.drain([&](int v) { drained.push_back(v); }, 2), 2u);
+    EXPECT_EQ(drained, (std::vector<int>{1, 2}));
+    EXPECT_EQ(ring.drain([&](int v) { drained.push_back(v); }, 8), 2u);
+    EXPECT_FALSE(ring.try_pop(value));
+}
+
+TEST(MpscRingTest, ManyProducersDeliverEverythingOnceInProducerOrder) {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 100'000;
+    MpscRing<std::uint64_t> ring(1024);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&ring, p] {
+            for (std::uint64_t i = 0; i < PER_PRODUCER; ++i) {
+                std::uint64_t item = static_cast<std::uint64_t>(p) << 32 | i;
+                while (!ring.try_push(item)) std::this_thread::yield();
+            }
+        });
+    }
+
+    std::vector<std::uint64_t> next(PRODUCERS, 0);
+    int received = 0;
+    bool ordered = true;
+    while (received < PRODUCERS * PER_PRODUCER) {
+        std::uint64_t item;
+        if (!ring.try_pop(item)) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::size_t p = item >> 32;
+        ordered &= (item & 0xFFFF'FFFF) == next[p];
+        next[p] = (item & 0xFFFF'FFFF) + 1;
+        ++received;
+    }
+    for (auto& producer : producers) producer.join();
+
+    EXPECT_TRUE(ordered);
+    for (int p = 0; p < PRODUCERS; ++p) EXPECT_EQ(next[p], static_cast<std::uint64_t>(PER_PRODUCER));
+}
+
+TEST(OrderGatewayTest, AcksReturnToTheSendingSession) {
+    OrderGateway<> gateway(2);
+    ASSERT_TRUE(gateway.submit(0, add(1, Side::BUY, 10, 100), 7));
+    ASSERT_TRUE(gateway.submit(1, add(2, Side::SELL, 4, 100), 8));
+    ASSERT_TRUE(gateway.submit(1, cancel(99)));
+    EXPECT_FALSE(gateway.submit(2, cancel(1)));
+
+    EXPECT_EQ(gateway.drain(), 3u);
+
+    OrderAck ack{};
+    ASSERT_TRUE(gateway.poll_ack(0, ack));
+    EXPECT_EQ(ack.id, 1u);
+    EXPECT_EQ(ack.tag, 7u);
+    EXPECT_TRUE(ack.accepted);
+    EXPECT_FALSE(gateway.poll_ack(0, ack));
+
+    ASSERT_TRUE(gateway.poll_ack(1, ack));
+    EXPECT_EQ(ack.id, 2u);
+    EXPECT_EQ(ack.type, CommandType::ADD);
+    ASSERT_TRUE(gateway.poll_ack(1, ack));
+    EXPECT_EQ(ack.type, CommandType::CANCEL);
+    EXPECT_FALSE(ack.accepted);
+
+    EXPECT_EQ(gateway.book().volume_at(Side::BUY, 100), 6);
+}
+
+TEST(OrderGatewayTest, FullAckRingBackpressuresOnlyThatSession) {
+    OrderGateway<> gateway(2, {}, 16, 2);
+    ASSERT_TRUE(gateway.submit(0, add(1, Side::BUY, 1, 100)));
+    ASSERT_TRUE(gateway.submit(0, add(2, Side::BUY, 1, 100)));
+    EXPECT_FALSE(gateway.submit(0, add(3, Side::BUY, 1, 100)));
+    EXPECT_EQ(gateway.in_flight(0), 2u);
+
+    // The other session still gets through
+    ASSERT_TRUE(gateway.submit(1, add(4, Side::SELL, 1, 200)));
+    EXPECT_EQ(gateway.drain(), 3u);
+
+    // Both acks fit the ring; until one is polled the session stays full
+    EXPECT_FALSE(gateway.submit(0, add(3, Side::BUY, 1, 100)));
+    OrderAck ack{};
+    ASSERT_TRUE(gateway.poll_ack(0, ack));
+    EXPECT_EQ(ack.id, 1u);
+    ASSERT_TRUE(gateway.submit(0, cancel(1)));
+    EXPECT_EQ(gateway.drain(), 1u);
+
+    ASSERT_TRUE(gateway.poll_ack(0, ack));
+    EXPECT_EQ(ack.id, 2u);
+    ASSERT_TRUE(gateway.poll_ack(0, ack));
+    EXPECT_EQ(ack.type, CommandType::CANCEL);
+    EXPECT_TRUE(ack.accepted);
+    EXPECT_FALSE(gateway.poll_ack(0, ack));
+    EXPECT_EQ(gateway.in_flight(0), 0u);
+    EXPECT_EQ(gateway.in_flight(1), 1u);
+    EXPECT_EQ(gateway.book().order_count(), 2u);
+}
+
+TEST(OrderGatewayTest, ConcurrentSessionsAgainstMatchingThread) {
+    constexpr SessionId SESSIONS = 4;
+    constexpr int ORDERS = 20'000;
+    OrderGateway<LimitOrderBook<PriceLadder>> gateway(SESSIONS, {}, 256, 1024);
+
+    std::jthread matcher([&](std::stop_token stop) { gateway.run(stop, 64); });
+
+    // Each session rests then cancels its own orders, reading acks as it goes
+    std::atomic<int> failures{0};
+    std::vector<std::thread> sessions;
+    for (SessionId s = 0; s < SESSIONS; ++s) {
+        sessions.emplace_back([&, s] {
+            int acked = 0;
+            auto poll = [&] {
+                OrderAck ack;
+                while (gateway.poll_ack(s, ack)) {
+                    if (!ack.accepted || ack.id / ORDERS != s) failures.fetch_add(1);
+                    ++acked;
+                }
+            };
+            Side side = s % 2 ? Side::SELL : Side::BUY;
+            int price = s % 2 ? 200 + static_cast<int>(s) : 100 - static_cast<int>(s);
+            for (int i = 0; i < ORDERS / 2; ++i) {
+                OrderId id = static_cast<OrderId>(s) * ORDERS + i;
+                while (!gateway.submit(s, add(id, side, 1, price))) poll();
+                while (!gateway.submit(s, cancel(id))) poll();
+                poll();
+            }
+            while (acked < ORDERS) {
+                poll();
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (auto& session : sessions) session.join();
+    matcher.request_stop();
+    matcher.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(gateway.book().order_count(), 0u);
+    for (SessionId s = 0; s < SESSIONS; ++s) EXPECT_EQ(gateway.in_flight(s), 0u);
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "FlowGenerator.h"
+#include "LimitOrderBook.h"
+#include "PriceLadder.h"
+#include <vector>
+
+TEST(PriceLadderTest, WindowSlidesWithoutGrowing) {
+    LimitOrderBook<PriceLadder> book(BookConfig{16});
+
+    // Walk the bid up far past the initial window; span stays tiny
+    for (int i = 0; i < 100; ++i) {
+        book.add_order({static_cast<OrderId>(i), Side::BUY, 10, 1000 + i});
+        if (i > 0) book.cancel_order(static_cast<OrderId>(i - 1));
+    }
+
+    EXPECT_EQ(book.best_bid(), 1099);
+    EXPECT_EQ(book.order_count(), 1u);
+}
+
+TEST(PriceLadderTest, GrowsAndKeepsOrdersLinked) {
+    PriceLadder<Side::SELL> ladder(BookConfig{4});
+    OrderNode low{1, Side::SELL, 100, 5};
+    OrderNode high{2, Side::SELL, 110, 7};
+
+    ladder.level_for(100).push_back(&low);
+    ladder.level_for(110).push_back(&high);
+
+    EXPECT_GE(ladder.capacity(), 11u);
+    ASSERT_NE(ladder.find(100), nullptr);
+    EXPECT_EQ(low.level, ladder.find(100));
+    EXPECT_EQ(high.level, ladder.find(110));
+    EXPECT_EQ(ladder.best()->price(), 100);
+}
+
+TEST(PriceLadderTest, BestFollowsErasedLevels) {
+    PriceLadder<Side::BUY> ladder;
+    OrderNode a{1, Side::BUY, 100, 1};
+    OrderNode b{2, Side::BUY, 97, 1};
+    OrderNode c{3, Side::BUY, 95, 1};
+    ladder.level_for(100).push_back(&a);
+    ladder.level_for(97).push_back(&b);
+    ladder.level_for(95).push_back(&c);
+
+    PriceLevel* best = ladder.best();
+    best->remove(&a);
+    ladder.erase(*best);
+    EXPECT_EQ(ladder.best()->price(), 97);
+
+    PriceLevel* worst = c.level;
+    worst->remove(&c);
+    ladder.erase(*worst);
+    EXPECT_EQ(ladder.find(95), nullptr);
+    EXPECT_EQ(ladder.best()->price(), 97);
+}
+
+TEST(PriceLadderTest, VisitsBestToWorst) {
+    PriceLadder<Side::SELL> ladder;
+    OrderNode a{1, Side::SELL, 103, 1};
+    OrderNode b{2, Side::SELL, 101, 1};
+    ladder.level_for(103).push_back(&a);
+    ladder.level_for(101).push_back(&b);
+
+    std::vector<int> prices;
+    ladder.for_each([&](const PriceLevel& level) { prices.push_back(level.price()); });
+    EXPECT_EQ(prices, (std::vector<int>{101, 103}));
+}
+
+TEST(PriceLadderTest, SweepsSparseBookAcrossWrap) {
+    LimitOrderBook<PriceLadder> book(BookConfig{4096});
+
+    // Asks scattered over most of the ring, offset so they wrap the array end
+    for (int i = 0; i < 8; ++i) {
+        book.add_order({static_cast<OrderId>(i), Side::SELL, 10, 3000 + i * 500});
+    }
+
+    book.add_order({100, Side::BUY, 35, 5000});
+    EXPECT_EQ(book.best_ask(), 4500);
+    EXPECT_EQ(book.volume_at(Side::SELL, 4500), 5);
+
+    book.add_order({101, Side::BUY, 100, 10000});
+    EXPECT_EQ(book.best_ask(), std::nullopt);
+    EXPECT_EQ(book.best_bid(), 10000);
+}
+
+TEST(PriceLadderTest, FarPricesSpillIntoTheMap) {
+    PriceLadder<Side::SELL> ladder(BookConfig{64, 0, 1024});
+    OrderNode near{1, Side::SELL, 100, 1};
+    OrderNode far{2, Side::SELL, 2'000'000'000, 1};
+    OrderNode front{3, Side::SELL, -2'000'000'000, 1};
+    ladder.level_for(100).push_back(&near);
+    ladder.level_for(2'000'000'000).push_back(&far);
+    ladder.level_for(-2'000'000'000).push_back(&front);
+
+    EXPECT_LE(ladder.capacity(), 1024u);
+    EXPECT_EQ(ladder.far_levels(), 2u);
+    EXPECT_EQ(ladder.heap_allocations(), 0u);
+    EXPECT_EQ(ladder.best()->price(), -2'000'000'000);
+    EXPECT_EQ(ladder.next_worse(-2'000'000'000)->price(), 100);
+    EXPECT_EQ(ladder.next_worse(100)->price(), 2'000'000'000);
+    EXPECT_EQ(far.level, ladder.find(2'000'000'000));
+    EXPECT_EQ(&ladder.level_for(2'000'000'000), far.level);
+
+    std::vector<int> prices;
+    ladder.for_each([&](const PriceLevel& level) { prices.push_back(level.price()); });
+    EXPECT_EQ(prices, (std::vector<int>{-2'000'000'000, 100, 2'000'000'000}));
+
+    PriceLevel* front_level = front.level;
+    front_level->remove(&front);
+    ladder.erase(*front_level);
+    EXPECT_EQ(ladder.best()->price(), 100);
+    EXPECT_EQ(ladder.far_levels(), 1u);
+}
+
+TEST(PriceLadderTest, NarrowSpanMatchesMapLevels) {
+    // A 32-tick span against flow 100 ticks wide keeps levels moving between
+    // the array and the map
+    LimitOrderBook<PriceLadder> ladder(BookConfig{16, 4096, 32});
+    LimitOrderBook<MapLevels> map;
+    FlowGenerator generator(FlowConfig{.seed = 31});
+    for (int i = 0; i < 50'000; ++i) {
+        OrderCommand command = generator.next();
+        ASSERT_EQ(apply(ladder, command), apply(map, command));
+        ASSERT_EQ(ladder.best_bid(), map.best_bid());
+        ASSERT_EQ(ladder.best_ask(), map.best_ask());
+    }
+
+    std::vector<Order> expected;
+    std::vector<Order> actual;
+    map.for_each_order([&](const Order& order) { expected.push_back(order); });
+    ladder.for_each_order([&](const Order& order) { actual.push_back(order); });
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].id, expected[i].id);
+        EXPECT_EQ(actual[i].quantity, expected[i].quantity);
+        EXPECT_EQ(actual[i].price, expected[i].price);
+    }
+}
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include "LimitOrderBook.h"
+#include "SlabPool.h"
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <random>
+
+// Count every global heap allocation in this binary, so the steady-state
+// test proves zero operator new calls rather than trusting the pools' own
+// counters.
+namespace {
+std::size_t g_heap_allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++g_heap_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++g_heap_allocations;
+    std::size_t alignment = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) return p;
+    throw std::bad_alloc();
+}
+
+// Out of line, or GCC inlines free() next to a call it knows as operator new
+// and warns about a mismatched pair
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+struct Widget {
+    int a;
+    double b;
+};
+
+}
+
+TEST(SlabPoolTest, ReusesFreedBlocks) {
+    ObjectPool<Widget> pool(4);
+    Widget* first = pool.create(1, 2.0);
+    EXPECT_EQ(first->a, 1);
+    EXPECT_EQ(pool.in_use(), 1u);
+
+    pool.destroy(first);
+    Widget* second = pool.create(3, 4.0);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(pool.heap_allocations(), 0u);
+}
+
+TEST(SlabPoolTest, CountsSlabsBeyondStartupCapacity) {
+    ObjectPool<Widget> pool(2);
+    Widget* a = pool.create();
+    Widget* b = pool.create();
+    EXPECT_EQ(pool.heap_allocations(), 0u);
+
+    Widget* c = pool.create();
+    EXPECT_EQ(pool.heap_allocations(), 1u);
+    EXPECT_EQ(pool.capacity(), 4u);
+
+    pool.destroy(a);
+    pool.destroy(b);
+    pool.destroy(c);
+    EXPECT_EQ(pool.in_use(), 0u);
+}
+
+TEST(SlabPoolTest, AllocatorServesMapNodesFromPool) {
+    SlabPool pool(128, alignof(std::max_align_t), 64);
+    std::map<int, int, std::less<int>, SlabAllocator<std::pair<const int, int>>> map{
+        SlabAllocator<std::pair<const int, int>>(pool)};
+
+    std::size_t before = g_heap_allocations;
+    for (int i = 0; i < 64; ++i) map[i] = i;
+    for (int i = 0; i < 64; ++i) map.erase(i);
+    std::size_t after = g_heap_allocations;
+
+    EXPECT_EQ(after - before, 0u);
+    EXPECT_EQ(pool.heap_allocations(), 0u);
+    EXPECT_EQ(pool.in_use(), 0u);
+}
+
+TEST(SlabPoolTest, MapLevelsBlocksFitTheLibraryNode) {
+    MapLevels<Side::SELL> asks(BookConfig{64, 0});
+
+    std::size_t before = g_heap_allocations;
+    for (int round = 0; round < 3; ++round) {
+        for (int price = 0; price < 64; ++price) asks.level_for(1000 + price);
+        for (int price = 0; price < 64; ++price) asks.erase(asks.level_for(1000 + price));
+    }
+    std::size_t after = g_heap_allocations;
+
+    EXPECT_EQ(after - before, 0u);
+    EXPECT_EQ(asks.heap_allocations(), 0u);
+
+    // Past capacity the pool grows by one slab, not a heap node per level
+    for (int price = 0; price < 80; ++price) asks.level_for(1000 + price);
+    EXPECT_EQ(asks.heap_allocations(), 1u);
+}
+
+template <typename Book>
+class SteadyStateAllocationTest : public ::testing::Test {};
+
+using Backends = ::testing::Types<LimitOrderBook<MapLevels>, LimitOrderBook<PriceLadder>>;
+TYPED_TEST_SUITE(SteadyStateAllocationTest, Backends);
+
+TYPED_TEST(SteadyStateAllocationTest, MatchingPathNeverAllocates) {
+    TypeParam book(BookConfig{256, 4096});
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> offset(1, 50);
+    std::uniform_int_distribution<int> qty(1, 100);
+    std::uniform_int_distribution<int> action(0, 9);
+
+    // Every step rests a passive order and cancels anything older than the
+    // last 500 ids, so at most 500 orders live; sweeps and amends mixed in.
+    auto run = [&](OrderId first_id, int steps) {
+        OrderId next_id = first_id;
+        OrderId oldest = first_id;
+        for (int i = 0; i < steps; ++i) {
+            bool buy = i & 1;
+            int price = buy ? 1000 - offset(rng) : 1000 + offset(rng);
+            book.add_order({next_id++, buy ? Side::BUY : Side::SELL, qty(rng), price});
+            while (next_id - oldest > 500) book.cancel_order(oldest++);
+
+            int a = action(rng);
+            if (a == 0) {
+                book.add_order({next_id++, buy ? Side::SELL : Side::BUY, 300, buy ? 970 : 1030});
+            }
+            else if (a == 1) {
+                book.modify_order(next_id - 1 - (i % 100), qty(rng));
+            }
+        }
+        return next_id;
+    };
+
+    OrderId next_id = run(1, 50'000);
+
+    std::size_t before = g_heap_allocations;
+    run(next_id, 200'000);
+    std::size_t after = g_heap_allocations;
+
+    EXPECT_EQ(after - before, 0u);
+    EXPECT_EQ(book.heap_allocations(), 0u);
+}
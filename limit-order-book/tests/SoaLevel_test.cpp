@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include "SoaLevel.h"
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Fill {
+    OrderId id;
+    std::int64_t traded;
+    std::int64_t leaves;
+    bool operator==(const Fill&) const = default;
+};
+
+// Reference: the same queue as a deque of (id, quantity)
+template <typename Traits>
+void check_against_deque(std::uint64_t seed) {
+    using Quantity = typename Traits::Quantity;
+    BasicSoaLevel<Traits> level(100, 8);
+    std::deque<std::pair<OrderId, Quantity>> queue;
+    std::mt19937 rng(seed);
+    OrderId next_id = 1;
+
+    for (int step = 0; step < 20'000; ++step) {
+        unsigned action = rng() % 10;
+        if (action < 5) {
+            Quantity quantity = static_cast<Quantity>(1 + rng() % 100);
+            level.push_back(next_id, quantity);
+            queue.emplace_back(next_id++, quantity);
+        }
+        else if (action < 7 && !queue.empty()) {
+            std::size_t i = rng() % queue.size();
+            ASSERT_TRUE(level.remove(queue[i].first));
+            queue.erase(queue.begin() + static_cast<std::ptrdiff_t>(i));
+        }
+        else {
+            Quantity quantity = static_cast<Quantity>(1 + rng() % 400);
+            std::vector<Fill> got;
+            Quantity traded = level.fill(quantity, [&](OrderId id, Quantity t, Quantity leaves) {
+                got.push_back({id, t, leaves});
+            });
+
+            std::vector<Fill> expected;
+            Quantity left = quantity;
+            while (left > 0 && !queue.empty()) {
+                auto& [id, open] = queue.front();
+                Quantity t = std::min(left, open);
+                open -= t;
+                left -= t;
+                expected.push_back({id, t, open});
+                if (open == 0) queue.pop_front();
+            }
+            ASSERT_EQ(traded, quantity - left) << "step " << step;
+            ASSERT_EQ(got, expected) << "step " << step;
+        }
+
+        ASSERT_EQ(level.order_count(), queue.size());
+        Quantity total = 0;
+        for (auto [id, quantity] : queue) total += quantity;
+        ASSERT_EQ(level.total_quantity(), total);
+    }
+}
+
+}
+
+TEST(SoaLevelTest, FillsOldestFirstAndKeepsThePartial) {
+    SoaLevel level(100);
+    for (OrderId id = 1; id <= 10; ++id) level.push_back(id, 10);
+
+    std::vector<Fill> fills;
+    EXPECT_EQ(level.fill(35, [&](OrderId id, int traded, int leaves) { fills.push_back({id, traded, leaves}); }), 35);
+    ASSERT_EQ(fills.size(), 4u);
+    EXPECT_EQ(fills[2], (Fill{3, 10, 0}));
+    EXPECT_EQ(fills[3], (Fill{4, 5, 5}));
+
+    EXPECT_EQ(level.order_count(), 7u);
+    EXPECT_EQ(level.ids().front(), 4u);
+    EXPECT_EQ(level.quantities().front(), 5);
+    EXPECT_EQ(level.total_quantity(), 65);
+}
+
+TEST(SoaLevelTest, RemoveCompactsAndKeepsPriority) {
+    SoaLevel level(100);
+    for (OrderId id = 1; id <= 5; ++id) level.push_back(id, 1);
+    EXPECT_TRUE(level.remove(3));
+    EXPECT_FALSE(level.remove(3));
+
+    std::vector<OrderId> ids(level.ids().begin(), level.ids().end());
+    EXPECT_EQ(ids, (std::vector<OrderId>{1, 2, 4, 5}));
+    EXPECT_EQ(level.total_quantity(), 4);
+}
+
+TEST(SoaLevelTest, FillLargerThanLevelTakesEverything) {
+    SoaLevel level(100);
+    level.push_back(1, 3);
+    level.push_back(2, 4);
+    EXPECT_EQ(level.fill(100, [](OrderId, int, int) {}), 7);
+    EXPECT_TRUE(level.empty());
+    EXPECT_EQ(level.total_quantity(), 0);
+}
+
+TEST(SoaLevelTest, MatchesReferenceQueue) {
+    check_against_deque<IntPrices>(1);
+    check_against_deque<WidePrices>(2);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include "LimitOrderBook.h"
+#include "FlowGenerator.h"
+#include "SeqLock.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int READERS = 4;
+
+struct Wide {
+    std::uint64_t a, b, c, d, e;
+};
+
+}
+
+TEST(SeqLockTest, LoadReturnsLastStore) {
+    SeqLock<Wide> lock;
+    EXPECT_EQ(lock.load().a, 0u);
+    EXPECT_EQ(lock.version(), 0u);
+
+    lock.store({1, 2, 3, 4, 5});
+    Wide value{};
+    ASSERT_TRUE(lock.try_load(value));
+    EXPECT_EQ(value.e, 5u);
+    EXPECT_EQ(lock.version(), 1u);
+}
+
+TEST(SeqLockTest, ReadersNeverSeeTornValues) {
+    constexpr std::uint64_t STORES = 500'000;
+    SeqLock<Wide> lock;
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&] {
+            std::uint64_t last = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                Wide value = lock.load();
+                bool torn = value.b != value.a || value.c != value.a || value.d != value.a || value.e != value.a;
+                if (torn || value.a < last) failures.fetch_add(1);
+                last = value.a;
+            }
+        });
+    }
+
+    for (std::uint64_t k = 1; k <= STORES; ++k) lock.store({k, k, k, k, k});
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(lock.load().a, STORES);
+}
+
+TEST(TopOfBookTest, PublishesBestBidAndOffer) {
+    LimitOrderBook<PriceLadder> book;
+    book.add_order({1, Side::BUY, 10, 99});
+    book.add_order({2, Side::SELL, 4, 101});
+    book.add_order({3, Side::SELL, 6, 102});
+
+    TopOfBook top = book.top_of_book().load();
+    EXPECT_EQ(top.bid_price, 99);
+    EXPECT_EQ(top.bid_quantity, 10);
+    EXPECT_EQ(top.ask_price, 101);
+    EXPECT_EQ(top.ask_quantity, 4);
+
+    // Deeper levels don't republish
+    std::uint64_t version = book.top_of_book().version();
+    book.add_order({4, Side::BUY, 5, 95});
+    EXPECT_EQ(book.top_of_book().version(), version);
+
+    book.add_order({5, Side::BUY, 4, 101});
+    top = book.top_of_book().load();
+    EXPECT_EQ(top.ask_price, 102);
+    EXPECT_EQ(top.ask_quantity, 6);
+
+    book.cancel_order(1);
+    book.cancel_order(4);
+    top = book.top_of_book().load();
+    EXPECT_EQ(top.bid_quantity, 0);
+}
+
+TEST(TopOfBookTest, ConcurrentReadersSeeConsistentQuotes) {
+    constexpr int MESSAGES = 300'000;
+    LimitOrderBook<PriceLadder> book;
+    std::atomic<bool> done{false};
+    std::atomic<int> failures{0};
+    std::atomic<std::uint64_t> reads{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; ++r) {
+        readers.emplace_back([&] {
+            std::uint64_t last = 0, count = 0;
+            while (!done.load(std::memory_order_acquire)) {
+                TopOfBook top = book.top_of_book().load();
+                bool crossed = top.bid_quantity > 0 && top.ask_quantity > 0 && top.bid_price >= top.ask_price;
+                if (crossed || top.bid_quantity < 0 || top.ask_quantity < 0 || top.sequence < last) {
+                    failures.fetch_add(1);
+                }
+                last = top.sequence;
+                ++count;
+            }
+            reads.fetch_add(count);
+        });
+    }
+
+    FlowGenerator flow;
+    for (int n = 0; n < MESSAGES; ++n) apply(book, flow.next());
+    done.store(true, std::memory_order_release);
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_GT(reads.load(), 0u);
+
+    TopOfBook top = book.top_of_book().load();
+    EXPECT_EQ(top.bid_price, book.best_bid().value_or(0));
+    EXPECT_EQ(top.ask_price, book.best_ask().value_or(0));
+}
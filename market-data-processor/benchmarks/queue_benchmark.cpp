@@ -1,12 +1,20 @@
+#include <algorithm>
+#include <deque>
 #include <chrono>
 #include <format>
 #include <iostream>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <thread>
+#include <vector>
 
+#include "clock.hpp"
 #include "lock_based_queue.hpp"
 #include "lock_free_queue.hpp"
+#include "mpmc_queue.hpp"
+#include "mpsc_queue.hpp"
+#include "multicast_ring.hpp"
 #include "market_sim.hpp"
 #include "signal_engine.hpp"
 #include "types.hpp"
@@ -19,6 +27,10 @@ namespace {
 constexpr int NUM_TICKS = 1'000'000;
 constexpr size_t RING_BUFFER_SIZE = 1024;
 
+// Timestamp and latency clock for every simulator and engine; set once from
+// the command line before any run
+ClockSource clock_source = ClockSource::SYSTEM;
+
 // Queue returning std::optional<T> from pop()
 template <typename Q, typename T>
 concept OptionalPopQueue = requires(Q q, const T& item) {
@@ -33,6 +45,22 @@ concept TryPopQueue = requires(Q q, T& out, const T& item) {
     { q.try_pop(out) } -> std::same_as<bool>;
 };
 
+// Queue with bulk copy and in-place batch APIs (LockFreeQueue)
+template <typename Q, typename T>
+concept BatchQueue = requires(Q q, std::span<const T> in, std::span<T> out, size_t n) {
+    { q.push_n(in) } -> std::same_as<size_t>;
+    { q.pop_n(out) } -> std::same_as<size_t>;
+    { q.try_claim(n) } -> std::same_as<std::span<T>>;
+    { q.peek(n) } -> std::same_as<std::span<const T>>;
+};
+
+// Queues that only allow one pushing thread
+template <typename Q>
+inline constexpr bool single_producer = false;
+
+template <typename T>
+inline constexpr bool single_producer<LockFreeQueue<T>> = true;
+
 // Adapts both pop interfaces to optional<T>
 template <typename Q, typename T>
 [[nodiscard]] std::optional<T> try_pop_unified(Q& queue) {
@@ -88,24 +116,30 @@ private:
     std::chrono::milliseconds& output_;
 };
 
+// producers threads, each with its own simulator, pushing NUM_TICKS ticks
+// between them one at a time; one consumer feeding them to engine. Returns
+// the wall time. single_producer queues must be run with one.
 template <typename QueueType>
-void run_simulation(std::string_view name, const std::string& csv_filename = "") {
-    std::cout << std::format("Starting Benchmark: {} ({} ticks)...\n", name, NUM_TICKS);
-
+std::chrono::milliseconds run_ticks(SignalEngine& engine, int producers = 1) {
     auto queue = make_queue<QueueType>();
-    MarketSimulator sim;
-    SignalEngine engine;
 
     std::chrono::milliseconds duration{};
 
     {
         ScopedTimer timer{duration};
 
-        std::jthread producer{[&] {
-            for (int i = 0; i < NUM_TICKS; ++i) {
-                push_unified<QueueType, Tick>(queue, sim.next_tick());
-            }
-        }};
+        std::vector<std::jthread> feeds;
+        feeds.reserve(producers);
+        for (int p = 0; p < producers; ++p) {
+            // First NUM_TICKS % producers feeds take one extra tick
+            int count = NUM_TICKS / producers + (p < NUM_TICKS % producers ? 1 : 0);
+            feeds.emplace_back([&queue, count] {
+                MarketSimulator sim(clock_source);
+                for (int i = 0; i < count; ++i) {
+                    push_unified<QueueType, Tick>(queue, sim.next_tick());
+                }
+            });
+        }
 
         std::jthread consumer{[&] {
             for (int processed = 0; processed < NUM_TICKS;) {
@@ -118,10 +152,23 @@ void run_simulation(std::string_view name, const std::string& csv_filename = "")
             }
         }};
     }  // jthreads join here, timer records duration
+    return duration;
+}
 
-    double seconds = duration.count() / 1000.0;
+// Returns the throughput in ticks/sec
+template <typename QueueType>
+double run_simulation(std::string_view name, const std::string& csv_filename = "", int producers = 1) {
+    std::cout << std::format("Starting Benchmark: {} ({} ticks, {} producer{}, {} clock)...\n",
+                             name, NUM_TICKS, producers, producers == 1 ? "" : "s", to_string(clock_source));
+
+    // Raw samples only when exporting, one per tick for the plots
+    SignalEngine engine(clock_source, csv_filename.empty() ? 0 : NUM_TICKS);
+    std::chrono::milliseconds duration = run_ticks<QueueType>(engine, producers);
+
+    double seconds = std::max<long long>(duration.count(), 1) / 1000.0;
+    double throughput = NUM_TICKS / seconds;
     std::cout << std::format("Total Wall Time: {}ms\n", duration.count());
-    std::cout << std::format("Throughput: {:.0f} ticks/sec\n", NUM_TICKS / seconds);
+    std::cout << std::format("Throughput: {:.0f} ticks/sec\n", throughput);
 
     engine.write_latency_report();
 
@@ -130,6 +177,244 @@ void run_simulation(std::string_view name, const std::string& csv_filename = "")
     }
 
     std::cout << std::string(50, '-') << "\n\n";
+    return throughput;
+}
+
+enum class BatchApi { COPY, IN_PLACE };
+
+// Same producer/consumer run, moving up to batch ticks per queue call:
+// COPY stages them in a local array for push_n/pop_n, IN_PLACE generates
+// them straight into claimed slots and processes them where they lie
+template <typename QueueType>
+    requires BatchQueue<QueueType, Tick>
+std::chrono::milliseconds run_batched(size_t batch, BatchApi api) {
+    constexpr size_t total = NUM_TICKS;
+    auto queue = make_queue<QueueType>();
+    MarketSimulator sim(clock_source);
+    SignalEngine engine(clock_source);
+
+    std::chrono::milliseconds duration{};
+    {
+        ScopedTimer timer{duration};
+
+        std::jthread producer{[&] {
+            std::vector<Tick> staged(batch);
+            for (size_t produced = 0; produced < total;) {
+                size_t n = std::min(batch, total - produced);
+                if (api == BatchApi::IN_PLACE) {
+                    std::span<Tick> slots = queue.try_claim(n);
+                    if (slots.empty()) {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    for (Tick& slot : slots) slot = sim.next_tick();
+                    queue.commit(slots.size());
+                    produced += slots.size();
+                    continue;
+                }
+                for (size_t i = 0; i < n; ++i) staged[i] = sim.next_tick();
+                for (size_t pushed = 0; pushed < n;) {
+                    size_t count = queue.push_n(std::span<const Tick>(staged).subspan(pushed, n - pushed));
+                    if (count == 0) std::this_thread::yield();
+                    pushed += count;
+                }
+                produced += n;
+            }
+        }};
+
+        std::jthread consumer{[&] {
+            std::vector<Tick> received(batch);
+            for (size_t processed = 0; processed < total;) {
+                size_t count = 0;
+                if (api == BatchApi::IN_PLACE) {
+                    std::span<const Tick> ready = queue.peek(batch);
+                    for (const Tick& tick : ready) engine.process_tick(tick);
+                    count = ready.size();
+                    queue.release(count);
+                } else {
+                    count = queue.pop_n(received);
+                    for (size_t i = 0; i < count; ++i) engine.process_tick(received[i]);
+                }
+                if (count == 0) std::this_thread::yield();
+                processed += count;
+            }
+        }};
+    }
+    return duration;
+}
+
+// Throughput at batch sizes 1-256 for both batch APIs, as a multiple of the
+// one-tick-per-call push()/pop() run
+template <typename QueueType>
+void run_batch_sweep(std::string_view name) {
+    std::cout << std::format("Batch Sweep: {} ({} ticks per run)\n", name, NUM_TICKS);
+
+    auto throughput = [](std::chrono::milliseconds duration) {
+        return NUM_TICKS / (std::max<long long>(duration.count(), 1) / 1000.0);
+    };
+
+    SignalEngine engine(clock_source);
+    double baseline = throughput(run_ticks<QueueType>(engine));
+    std::cout << std::format("push()/pop(): {:.0f} ticks/sec\n\n", baseline);
+
+    std::cout << std::format("{:>6} {:>16} {:>7} {:>16} {:>7}\n", "Batch", "push_n/pop_n", "Gain", "claim/peek", "Gain");
+    for (size_t batch = 1; batch <= 256; batch *= 2) {
+        double copy = throughput(run_batched<QueueType>(batch, BatchApi::COPY));
+        double in_place = throughput(run_batched<QueueType>(batch, BatchApi::IN_PLACE));
+        std::cout << std::format("{:>6} {:>16.0f} {:>6.2f}x {:>16.0f} {:>6.2f}x\n",
+                                 batch, copy, copy / baseline, in_place, in_place / baseline);
+    }
+    std::cout << std::string(50, '-') << "\n\n";
+}
+
+constexpr int PRODUCER_COUNTS[] = {1, 2, 4, 8};
+
+// One row of the fan-in table: QueueType at every producer count, 0 where
+// the queue can't take that many producers
+template <typename QueueType>
+std::vector<double> run_producer_row(std::string_view name) {
+    std::vector<double> row;
+    for (int producers : PRODUCER_COUNTS) {
+        if (single_producer<QueueType> && producers > 1) {
+            row.push_back(0.0);
+            continue;
+        }
+        row.push_back(run_simulation<QueueType>(name, "", producers));
+    }
+    return row;
+}
+
+// Fan-in: every queue at 1, 2, 4 and 8 producer threads into one consumer,
+// each run's latency report followed by a throughput table
+void run_producer_sweep() {
+    std::vector<std::pair<std::string_view, std::vector<double>>> rows;
+    rows.emplace_back("Lock-Based (Mutex)", run_producer_row<ThreadSafeQueue<Tick>>("Lock-Based (Mutex)"));
+    rows.emplace_back("Lock-Free SPSC", run_producer_row<LockFreeQueue<Tick>>("Lock-Free SPSC"));
+    rows.emplace_back("Lock-Free MPSC", run_producer_row<MpscQueue<Tick>>("Lock-Free MPSC"));
+    rows.emplace_back("Lock-Free MPMC", run_producer_row<MpmcQueue<Tick>>("Lock-Free MPMC"));
+
+    std::cout << "Throughput (ticks/sec) by producer count\n";
+    std::cout << std::format("{:<20}", "Queue");
+    for (int producers : PRODUCER_COUNTS) std::cout << std::format(" {:>12}", producers);
+    std::cout << "\n";
+    for (const auto& [name, row] : rows) {
+        std::cout << std::format("{:<20}", name);
+        for (double throughput : row) {
+            std::cout << (throughput > 0 ? std::format(" {:>12.0f}", throughput) : std::format(" {:>12}", "-"));
+        }
+        std::cout << "\n";
+    }
+    std::cout << std::string(50, '-') << "\n\n";
+}
+
+constexpr size_t FANOUT_BATCH = 64;  // Max ticks a fan-out consumer reads per call
+
+// One producer, consumers threads each running every tick through its own
+// SignalEngine. The baseline for MulticastRing: the producer copies every
+// tick into one LockFreeQueue per consumer.
+std::chrono::milliseconds run_copied_fanout(size_t consumers) {
+    constexpr size_t total = NUM_TICKS;
+    std::deque<LockFreeQueue<Tick>> queues;
+    for (size_t c = 0; c < consumers; ++c) queues.emplace_back(RING_BUFFER_SIZE);
+    std::deque<SignalEngine> engines;
+    for (size_t c = 0; c < consumers; ++c) engines.emplace_back(clock_source);
+    MarketSimulator sim(clock_source);
+
+    std::chrono::milliseconds duration{};
+    {
+        ScopedTimer timer{duration};
+
+        std::vector<std::jthread> readers;
+        for (size_t c = 0; c < consumers; ++c) {
+            readers.emplace_back([&queue = queues[c], &engine = engines[c]] {
+                for (size_t processed = 0; processed < total;) {
+                    std::span<const Tick> ready = queue.peek(FANOUT_BATCH);
+                    for (const Tick& tick : ready) engine.process_tick(tick);
+                    queue.release(ready.size());
+                    if (ready.empty()) std::this_thread::yield();
+                    processed += ready.size();
+                }
+            });
+        }
+
+        std::jthread producer{[&] {
+            for (size_t i = 0; i < total; ++i) {
+                Tick tick = sim.next_tick();
+                for (auto& queue : queues) push_unified<LockFreeQueue<Tick>, Tick>(queue, tick);
+            }
+        }};
+    }
+    return duration;
+}
+
+// Same fan-out through one MulticastRing: the producer writes each tick once
+// and every consumer reads it in place. Chained registers each consumer
+// behind the one before it instead of all reading independently.
+std::chrono::milliseconds run_multicast_fanout(size_t consumers, bool chained) {
+    constexpr size_t total = NUM_TICKS;
+    MulticastRing<Tick> ring(RING_BUFFER_SIZE, consumers);
+    for (size_t c = 0; c < consumers; ++c) {
+        if (chained && c > 0) {
+            ring.add_consumer({c - 1});
+        } else {
+            ring.add_consumer();
+        }
+    }
+    std::deque<SignalEngine> engines;
+    for (size_t c = 0; c < consumers; ++c) engines.emplace_back(clock_source);
+    MarketSimulator sim(clock_source);
+
+    std::chrono::milliseconds duration{};
+    {
+        ScopedTimer timer{duration};
+
+        std::vector<std::jthread> readers;
+        for (size_t c = 0; c < consumers; ++c) {
+            readers.emplace_back([&ring, &engine = engines[c], c] {
+                for (size_t processed = 0; processed < total;) {
+                    std::span<const Tick> ready = ring.peek(c, FANOUT_BATCH);
+                    for (const Tick& tick : ready) engine.process_tick(tick);
+                    ring.release(c, ready.size());
+                    if (ready.empty()) std::this_thread::yield();
+                    processed += ready.size();
+                }
+            });
+        }
+
+        std::jthread producer{[&] {
+            for (size_t produced = 0; produced < total;) {
+                std::span<Tick> slot = ring.try_claim(1);
+                if (slot.empty()) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                slot[0] = sim.next_tick();
+                ring.commit(1);
+                ++produced;
+            }
+        }};
+    }
+    return duration;
+}
+
+// Throughput (ticks/sec delivered to every consumer) with 1-4 consumers:
+// copies into per-consumer queues vs the multicast ring, independent and
+// chained
+void run_fanout_sweep() {
+    std::cout << std::format("Fan-out Sweep: ({} ticks per run, every consumer sees every tick)\n", NUM_TICKS);
+
+    auto throughput = [](std::chrono::milliseconds duration) {
+        return NUM_TICKS / (std::max<long long>(duration.count(), 1) / 1000.0);
+    };
+
+    std::cout << std::format("{:>9} {:>16} {:>16} {:>16}\n", "Consumers", "Copied queues", "Multicast", "Chained");
+    for (size_t consumers = 1; consumers <= 4; ++consumers) {
+        double copied = throughput(run_copied_fanout(consumers));
+        double multicast = throughput(run_multicast_fanout(consumers, false));
+        double chained = throughput(run_multicast_fanout(consumers, true));
+        std::cout << std::format("{:>9} {:>16.0f} {:>16.0f} {:>16.0f}\n", consumers, copied, multicast, chained);
+    }
+    std::cout << std::string(50, '-') << "\n\n";
 }
 
 }  // namespace
@@ -137,6 +422,21 @@ void run_simulation(std::string_view name, const std::string& csv_filename = "")
 int main(int argc, char* argv[]) {
     std::string_view mode = (argc > 1) ? argv[1] : "both";
 
+    // Optional second argument picks the clock: system (default), steady, tsc
+    if (argc > 2) {
+        std::optional<ClockSource> source = parse_clock_source(argv[2]);
+        if (!source) {
+            std::cerr << std::format("Unknown clock '{}': expected system, steady or tsc\n", argv[2]);
+            return 1;
+        }
+        clock_source = Clock(*source).source();
+        if (*source == ClockSource::TSC && clock_source != ClockSource::TSC) {
+            std::cout << "No invariant TSC on this CPU; using the steady clock\n";
+        } else if (clock_source == ClockSource::TSC) {
+            std::cout << std::format("TSC calibrated at {:.3f} GHz\n", TscClock::ticks_per_ns());
+        }
+    }
+
     if (mode == "lock" || mode == "both") {
         run_simulation<ThreadSafeQueue<Tick>>("Lock-Based (Mutex)", "data/latency_lock_based.csv");
     }
@@ -145,6 +445,26 @@ int main(int argc, char* argv[]) {
         run_simulation<LockFreeQueue<Tick>>("Lock-Free (Atomic)", "data/latency_lock_free.csv");
     }
 
+    if (mode == "mpsc") {
+        run_simulation<MpscQueue<Tick>>("Lock-Free MPSC", "data/latency_mpsc.csv");
+    }
+
+    if (mode == "mpmc") {
+        run_simulation<MpmcQueue<Tick>>("Lock-Free MPMC", "data/latency_mpmc.csv");
+    }
+
+    if (mode == "producers") {
+        run_producer_sweep();
+    }
+
+    if (mode == "fanout") {
+        run_fanout_sweep();
+    }
+
+    if (mode == "batch") {
+        run_batch_sweep<LockFreeQueue<Tick>>("Lock-Free (Atomic)");
+    }
+
     if (mode == "both") {
         std::cout << "\n=== CSV files exported for visualization ===" << std::endl;
         std::cout << "  - data/latency_lock_based.csv" << std::endl;
@@ -2,8 +2,16 @@
 
 #include <benchmark/benchmark.h>
 #include "lock_based_queue.hpp"
+#include "clock.hpp"
+#include "latency_histogram.hpp"
 #include "lock_free_queue.hpp"
+#include "mpmc_queue.hpp"
+#include "mpsc_queue.hpp"
 #include "types.hpp"
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
 
 constexpr int BURST_SIZE = 100;  // Fits in cache, under ring buffer capacity
 
@@ -43,9 +51,95 @@ void BM_LockFreeQueue(benchmark::State& state) {
     }
 }
 
+// Same burst moved with one push_n and one pop_n
+void BM_LockFreeQueueBulk(benchmark::State& state) {
+    LockFreeQueue<Tick> queue(1024);
+    std::vector<Tick> in(BURST_SIZE);
+    std::vector<Tick> out(BURST_SIZE);
+
+    for (auto _ : state) {
+        size_t pushed = queue.push_n(in);
+        size_t popped = queue.pop_n(out);
+        benchmark::DoNotOptimize(pushed);
+        benchmark::DoNotOptimize(popped);
+        benchmark::DoNotOptimize(out.data());
+    }
+}
+
+// Same burst written and read in place through try_claim/commit, peek/release
+void BM_LockFreeQueueInPlace(benchmark::State& state) {
+    LockFreeQueue<Tick> queue(1024);
+    Tick dummy_tick{};
+
+    for (auto _ : state) {
+        for (size_t done = 0; done < BURST_SIZE;) {
+            std::span<Tick> slots = queue.try_claim(BURST_SIZE - done);
+            for (Tick& slot : slots) slot = dummy_tick;
+            queue.commit(slots.size());
+            done += slots.size();
+        }
+        for (size_t done = 0; done < BURST_SIZE;) {
+            std::span<const Tick> ready = queue.peek(BURST_SIZE - done);
+            benchmark::DoNotOptimize(ready.data());
+            queue.release(ready.size());
+            done += ready.size();
+        }
+    }
+}
+
+// Same burst through the multi-producer queues: the cost of the per-slot
+// sequence and the claim CAS with no contention
+template <typename Q>
+void BM_SequencedQueue(benchmark::State& state) {
+    Q queue(1024);
+    Tick dummy_tick{};
+
+    for (auto _ : state) {
+        for (int i = 0; i < BURST_SIZE; ++i) {
+            queue.push(dummy_tick);
+        }
+
+        for (int i = 0; i < BURST_SIZE; ++i) {
+            auto res = queue.pop();
+            benchmark::DoNotOptimize(res);
+        }
+    }
+}
+
+// Cost of one latency record into the fixed-size histogram
+void BM_LatencyHistogramRecord(benchmark::State& state) {
+    auto histogram = std::make_unique<LatencyHistogram>();
+    int64_t latency = 1;
+
+    for (auto _ : state) {
+        histogram->record(latency);
+        latency = (latency * 7 + 13) & 0xFFFFF;  // Spread over ~1ms of buckets
+    }
+    benchmark::DoNotOptimize(histogram->count());
+}
+
+// Cost of one timestamp from each clock backend
+template <ClockSource Source>
+void BM_ClockNow(benchmark::State& state) {
+    Clock clock(Source);
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clock.now());
+    }
+    state.SetLabel(std::string(to_string(clock.source())));
+}
+
 }  // namespace
 
 BENCHMARK(BM_LockBasedQueue);
 BENCHMARK(BM_LockFreeQueue);
+BENCHMARK(BM_LockFreeQueueBulk);
+BENCHMARK(BM_LockFreeQueueInPlace);
+BENCHMARK(BM_SequencedQueue<MpscQueue<Tick>>);
+BENCHMARK(BM_SequencedQueue<MpmcQueue<Tick>>);
+BENCHMARK(BM_LatencyHistogramRecord);
+BENCHMARK(BM_ClockNow<ClockSource::SYSTEM>);
+BENCHMARK(BM_ClockNow<ClockSource::STEADY>);
+BENCHMARK(BM_ClockNow<ClockSource::TSC>);
 
 BENCHMARK_MAIN();
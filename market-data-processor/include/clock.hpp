@@ -0,0 +1,164 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define MDP_HAS_TSC 1
+#else
+#define MDP_HAS_TSC 0
+#endif
+
+// Where tick timestamps and receive times come from. Producer and consumer
+// must use the same source, since latency is one's reading minus the other's.
+enum class ClockSource : uint8_t {
+    SYSTEM,   // system_clock: wall time, not monotonic (the original behaviour)
+    STEADY,   // steady_clock: monotonic
+    TSC       // Time-stamp counter scaled to steady_clock nanoseconds
+};
+
+[[nodiscard]] inline std::string_view to_string(ClockSource source) {
+    switch (source) {
+        case ClockSource::SYSTEM: return "system";
+        case ClockSource::STEADY: return "steady";
+        case ClockSource::TSC: return "tsc";
+    }
+    return "unknown";
+}
+
+[[nodiscard]] inline std::optional<ClockSource> parse_clock_source(std::string_view name) {
+    if (name == "system") return ClockSource::SYSTEM;
+    if (name == "steady") return ClockSource::STEADY;
+    if (name == "tsc") return ClockSource::TSC;
+    return std::nullopt;
+}
+
+// Reads the x86 time-stamp counter as steady_clock nanoseconds.
+//
+// Only trusted with an invariant TSC (CPUID 0x80000007 EDX bit 8): one that
+// ticks at a constant rate through frequency changes and sleep states and is
+// synchronized across cores, so a stamp taken on the producer's core can be
+// subtracted from one taken on the consumer's. Uses rdtscp where the CPU has
+// it, which waits for earlier instructions to finish, so a receive stamp
+// isn't read ahead of the pop it measures.
+//
+// The rate is calibrated once, on first use, by spinning ~20ms against
+// steady_clock; ticks are then converted with a 32.32 fixed-point multiply.
+class TscClock {
+public:
+    // Invariant TSC present (always false off x86)
+    [[nodiscard]] static bool available() { return calibration().invariant; }
+
+    [[nodiscard]] static uint64_t now() {
+        const Calibration& c = calibration();
+        uint64_t elapsed = read(c.has_rdtscp) - c.base_ticks;
+        return c.base_ns + static_cast<uint64_t>((static_cast<unsigned __int128>(elapsed) * c.ns_per_tick_q32) >> 32);
+    }
+
+    // Measured counter frequency, in ticks per nanosecond (GHz)
+    [[nodiscard]] static double ticks_per_ns() {
+        return 4294967296.0 / static_cast<double>(calibration().ns_per_tick_q32);
+    }
+
+private:
+    struct Calibration {
+        bool invariant = false;
+        bool has_rdtscp = false;
+        uint64_t base_ticks = 0;
+        uint64_t base_ns = 0;
+        uint64_t ns_per_tick_q32 = uint64_t{1} << 32;
+    };
+
+    static uint64_t read([[maybe_unused]] bool has_rdtscp) {
+#if MDP_HAS_TSC
+        if (has_rdtscp) {
+            unsigned int aux;
+            return __rdtscp(&aux);
+        }
+        return __rdtsc();
+#else
+        return 0;
+#endif
+    }
+
+    static uint64_t steady_ns() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // Pairs a steady_clock reading with the counter at the same instant,
+    // taking the counter midway between reads on either side of it
+    static void sample(bool has_rdtscp, uint64_t& ticks, uint64_t& ns) {
+        uint64_t before = read(has_rdtscp);
+        ns = steady_ns();
+        uint64_t after = read(has_rdtscp);
+        ticks = before + (after - before) / 2;
+    }
+
+    static Calibration calibrate() {
+        Calibration c;
+#if MDP_HAS_TSC
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx)) {
+            c.has_rdtscp = (edx >> 27) & 1;
+        }
+        if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+            c.invariant = (edx >> 8) & 1;
+        }
+#endif
+        if (!c.invariant) return c;
+
+        uint64_t start_ticks, start_ns, end_ticks, end_ns;
+        sample(c.has_rdtscp, start_ticks, start_ns);
+        do {
+            sample(c.has_rdtscp, end_ticks, end_ns);
+        } while (end_ns - start_ns < 20'000'000);
+
+        c.base_ticks = end_ticks;
+        c.base_ns = end_ns;
+        c.ns_per_tick_q32 = static_cast<uint64_t>(
+            static_cast<double>(end_ns - start_ns) / static_cast<double>(end_ticks - start_ticks) * 4294967296.0);
+        return c;
+    }
+
+    static const Calibration& calibration() {
+        static const Calibration instance = calibrate();
+        return instance;
+    }
+};
+
+// The source a clock asking for requested actually reads: TSC needs an
+// invariant counter and falls back to STEADY without one
+[[nodiscard]] inline ClockSource usable_clock_source(ClockSource requested, bool tsc_available) {
+    return requested == ClockSource::TSC && !tsc_available ? ClockSource::STEADY : requested;
+}
+
+// Nanosecond timestamps from a chosen source. TSC falls back to STEADY (and
+// source() says so) when the CPU has no invariant TSC.
+class Clock {
+public:
+    explicit Clock(ClockSource source = ClockSource::SYSTEM)
+        : source_(usable_clock_source(source, source == ClockSource::TSC && TscClock::available())) {}
+
+    [[nodiscard]] ClockSource source() const { return source_; }
+
+    [[nodiscard]] uint64_t now() const {
+        switch (source_) {
+            case ClockSource::TSC:
+                return TscClock::now();
+            case ClockSource::STEADY:
+                return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch()).count());
+            case ClockSource::SYSTEM:
+                break;
+        }
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+private:
+    ClockSource source_;
+};
@@ -0,0 +1,104 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+// Fixed-memory log-linear (HDR-style) latency histogram, in nanoseconds.
+//
+// Values below 256 get a bucket each. Above that, every power of two is
+// split into 128 equal buckets, so a recorded value is off by at most 1/128
+// (< 0.8%) of itself, over the whole 64-bit range, in ~58KB that never grows.
+// record() is a bit scan and a counter increment.
+//
+// One thread records; any thread may read count()/percentile() meanwhile,
+// getting a slightly stale but valid view (counters are relaxed atomics,
+// bumped without a locked instruction since there is a single writer).
+// Merge per-thread histograms with merge() for a combined report.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 7;
+    static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    // Writer thread only; negative latencies (clock skew) count as 0
+    void record(int64_t value) {
+        uint64_t v = value > 0 ? static_cast<uint64_t>(value) : 0;
+        bump(counts_[index_of(v)], 1);
+        bump(count_, 1);
+        bump(sum_, v);
+        if (v < min_.load(std::memory_order_relaxed)) min_.store(v, std::memory_order_relaxed);
+        if (v > max_.load(std::memory_order_relaxed)) max_.store(v, std::memory_order_relaxed);
+    }
+
+    // Writer thread only; adds other's recorded values to this histogram
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            bump(counts_[i], other.counts_[i].load(std::memory_order_relaxed));
+        }
+        bump(count_, other.count_.load(std::memory_order_relaxed));
+        bump(sum_, other.sum_.load(std::memory_order_relaxed));
+        min_.store(std::min(min_.load(std::memory_order_relaxed), other.min_.load(std::memory_order_relaxed)),
+                   std::memory_order_relaxed);
+        max_.store(std::max(max_.load(std::memory_order_relaxed), other.max_.load(std::memory_order_relaxed)),
+                   std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    [[nodiscard]] bool empty() const { return count() == 0; }
+
+    // Exact; 0 if empty
+    [[nodiscard]] int64_t min() const { return empty() ? 0 : static_cast<int64_t>(min_.load(std::memory_order_relaxed)); }
+    [[nodiscard]] int64_t max() const { return static_cast<int64_t>(max_.load(std::memory_order_relaxed)); }
+    [[nodiscard]] double mean() const {
+        uint64_t n = count();
+        return n == 0 ? 0.0 : static_cast<double>(sum_.load(std::memory_order_relaxed)) / n;
+    }
+
+    // Smallest bucket bound that at least p percent (0-100) of the values
+    // are at or under, capped at max(); 0 if empty
+    [[nodiscard]] int64_t percentile(double p) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        if (p <= 0.0) return min();
+
+        auto rank = static_cast<uint64_t>(std::ceil(std::min(p, 100.0) / 100.0 * n));
+        rank = std::max<uint64_t>(rank, 1);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= rank) {
+                return std::min(static_cast<int64_t>(highest_in(i)), max());
+            }
+        }
+        return max();  // Only reachable mid-record, when count_ ran ahead
+    }
+
+private:
+    static void bump(std::atomic<uint64_t>& counter, uint64_t by) {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    // Below 2 * SUB_BUCKETS the bucket is the value itself; above, the top
+    // SUB_BUCKET_BITS + 1 bits pick a bucket within the value's power of two
+    static size_t index_of(uint64_t v) {
+        int shift = std::max(0, static_cast<int>(std::bit_width(v)) - (SUB_BUCKET_BITS + 1));
+        return static_cast<size_t>(shift) * SUB_BUCKETS + static_cast<size_t>(v >> shift);
+    }
+
+    static uint64_t highest_in(size_t index) {
+        if (index < 2 * SUB_BUCKETS) return index;
+        size_t shift = index / SUB_BUCKETS - 1;
+        uint64_t sub = index - shift * SUB_BUCKETS;
+        return (sub << shift) + ((uint64_t{1} << shift) - 1);
+    }
+
+    std::array<std::atomic<uint64_t>, BUCKETS> counts_{};
+    std::atomic<uint64_t> count_{0};
+    std::atomic<uint64_t> sum_{0};
+    std::atomic<uint64_t> min_{UINT64_MAX};
+    std::atomic<uint64_t> max_{0};
+};
@@ -2,54 +2,158 @@
 #include <vector>
 #include <atomic>
 #include <optional>
+#include <span>
+#include <algorithm>
 
 // Single-producer, single-consumer lock-free ring buffer queue.
+//
+// Capacity is rounded up to a power of two so a slot is index & mask, and
+// head/tail run free (never wrapped), so every slot is usable. Each side
+// keeps a cached copy of the other side's index and only reloads it when the
+// cache says full/empty, so steady-state calls touch no shared cache line.
+//
+// Besides push/pop of single items:
+//   push_n / pop_n     - copy a batch in or out, one index publish per batch
+//   try_claim / commit - producer writes straight into the ring's slots
+//   peek / release     - consumer reads straight from the ring's slots
 template<typename T>
 class LockFreeQueue {
 public:
-    // Allocates size+1 slots (one slot reserved to distinguish full vs empty)
     explicit LockFreeQueue(size_t size)
-        : buffer_(size + 1), head_(0), tail_(0) {}
+        : buffer_(round_up_pow2(size)), mask_(buffer_.size() - 1) {}
+
+    LockFreeQueue(const LockFreeQueue&) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue&) = delete;
+
+    [[nodiscard]] size_t capacity() const { return buffer_.size(); }
 
     // Returns false if queue is full
     bool push(const T& item) {
         size_t current_head = head_.load(std::memory_order_relaxed);
-        size_t current_tail = tail_.load(std::memory_order_acquire);
-        size_t next_head = (current_head + 1) % buffer_.size();
-
-        if (next_head == current_tail) {
-            return false;  // Full
+        if (current_head - cached_tail_ == buffer_.size()) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (current_head - cached_tail_ == buffer_.size()) {
+                return false;  // Full
+            }
         }
 
         // Safe: consumer won't read this slot until head is published
-        buffer_[current_head] = item;
+        buffer_[current_head & mask_] = item;
 
         // Release: ensures write completes before consumer sees new head
-        head_.store(next_head, std::memory_order_release);
+        head_.store(current_head + 1, std::memory_order_release);
         return true;
     }
 
     // Returns nullopt if queue is empty
     [[nodiscard]] std::optional<T> pop() {
         size_t current_tail = tail_.load(std::memory_order_relaxed);
-        size_t current_head = head_.load(std::memory_order_acquire);
-
-        if (current_head == current_tail) {
-            return std::nullopt;  // Empty
+        if (current_tail == cached_head_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (current_tail == cached_head_) {
+                return std::nullopt;  // Empty
+            }
         }
 
-        T item = buffer_[current_tail];
-        size_t next_tail = (current_tail + 1) % buffer_.size();
+        T item = buffer_[current_tail & mask_];
 
         // Release: signals producer that slot is now free
-        tail_.store(next_tail, std::memory_order_release);
+        tail_.store(current_tail + 1, std::memory_order_release);
         return item;
     }
 
+    // Pushes as many of items as fit; returns how many
+    size_t push_n(std::span<const T> items) {
+        size_t current_head = head_.load(std::memory_order_relaxed);
+        size_t n = std::min(items.size(), free_slots(current_head, items.size()));
+        for (size_t i = 0; i < n; ++i) {
+            buffer_[(current_head + i) & mask_] = items[i];
+        }
+        if (n > 0) {
+            head_.store(current_head + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // Pops up to out.size() items into out; returns how many
+    size_t pop_n(std::span<T> out) {
+        size_t current_tail = tail_.load(std::memory_order_relaxed);
+        size_t n = std::min(out.size(), filled_slots(current_tail, out.size()));
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = buffer_[(current_tail + i) & mask_];
+        }
+        if (n > 0) {
+            tail_.store(current_tail + n, std::memory_order_release);
+        }
+        return n;
+    }
+
+    // Producer: up to max free slots to construct items in place, contiguous
+    // (stops at the wrap point). Empty if full. Nothing is visible to the
+    // consumer until commit().
+    [[nodiscard]] std::span<T> try_claim(size_t max = 1) {
+        size_t current_head = head_.load(std::memory_order_relaxed);
+        size_t start = current_head & mask_;
+        size_t n = std::min({max, free_slots(current_head, max), buffer_.size() - start});
+        return {buffer_.data() + start, n};
+    }
+
+    // Producer: publishes the first count slots of the last claim
+    void commit(size_t count = 1) {
+        head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Consumer: up to max ready items to read in place, contiguous (stops at
+    // the wrap point). Empty if the queue is. Slots stay owned by the
+    // consumer until release().
+    [[nodiscard]] std::span<const T> peek(size_t max = 1) {
+        size_t current_tail = tail_.load(std::memory_order_relaxed);
+        size_t start = current_tail & mask_;
+        size_t n = std::min({max, filled_slots(current_tail, max), buffer_.size() - start});
+        return {buffer_.data() + start, n};
+    }
+
+    // Consumer: hands the first count peeked slots back to the producer
+    void release(size_t count = 1) {
+        tail_.store(tail_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
 private:
+    static size_t round_up_pow2(size_t n) {
+        size_t size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    // Producer side; reloads the consumer's index only if the cache shows
+    // fewer than wanted slots free
+    size_t free_slots(size_t current_head, size_t wanted) {
+        size_t free = buffer_.size() - (current_head - cached_tail_);
+        if (free < wanted) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            free = buffer_.size() - (current_head - cached_tail_);
+        }
+        return free;
+    }
+
+    // Consumer side; reloads the producer's index only if the cache shows
+    // fewer than wanted items ready
+    size_t filled_slots(size_t current_tail, size_t wanted) {
+        size_t filled = cached_head_ - current_tail;
+        if (filled < wanted) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            filled = cached_head_ - current_tail;
+        }
+        return filled;
+    }
+
     std::vector<T> buffer_;
+    size_t mask_;
 
-    // Cache-line aligned to prevent false sharing between producer/consumer
-    alignas(64) std::atomic<size_t> head_;
-    alignas(64) std::atomic<size_t> tail_;
+    // Cache-line aligned to prevent false sharing between producer/consumer;
+    // each side's cached copy of the other's index sits on its own line
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0;
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0;
 };
@@ -1,5 +1,6 @@
 #pragma once
 #include "types.hpp"
+#include "clock.hpp"
 #include <random>
 
 // Generates synthetic market ticks with random walk pricing.
@@ -12,8 +13,10 @@ private:
     std::uniform_int_distribution<> qty_dist_;      // Trade quantity
     std::uniform_int_distribution<> side_dist_;     // BUY (0) or SELL (1)
 
+    Clock clock_;                                   // Tick timestamps
+
 public:
-    MarketSimulator();
+    explicit MarketSimulator(ClockSource clock = ClockSource::SYSTEM);
 
     // Generates next tick, advancing internal state
     Tick next_tick();
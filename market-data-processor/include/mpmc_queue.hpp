@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <optional>
+
+// Bounded multi-producer, multi-consumer lock-free queue (Vyukov).
+//
+// Every slot carries a sequence number saying whose turn it is: a slot at
+// position pos is free for the producer claiming pos when sequence == pos,
+// and ready for the consumer claiming pos when sequence == pos + 1. Each
+// side claims positions by CAS on its own counter, then publishes through
+// the slot's sequence, so producers and consumers only contend with their
+// own kind and never on a shared lock. Capacity is rounded up to a power of
+// two.
+template<typename T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(size_t size)
+        : slots_(round_up_pow2(size)), mask_(slots_.size() - 1) {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    [[nodiscard]] size_t capacity() const { return slots_.size(); }
+
+    // Any thread; returns false if queue is full
+    bool push(const T& item) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                // Slot free for pos: claim it (a failed CAS reloads pos)
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.item = item;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full: the slot still holds an item from a lap ago
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);  // Another producer got there first
+            }
+        }
+    }
+
+    // Any thread; returns nullopt if queue is empty
+    [[nodiscard]] std::optional<T> pop() {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    T item = slot.item;
+                    // Free for the producer one lap ahead
+                    slot.sequence.store(pos + slots_.size(), std::memory_order_release);
+                    return item;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;  // Empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T item;
+    };
+
+    static size_t round_up_pow2(size_t n) {
+        size_t size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+
+    // Producers and consumers each hammer their own line
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+};
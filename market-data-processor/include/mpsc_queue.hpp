@@ -0,0 +1,80 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <optional>
+
+// Bounded multi-producer, single-consumer lock-free queue.
+//
+// Producers claim positions by CAS and publish each slot through its own
+// sequence number, as in MpmcQueue, so a slow producer never exposes a
+// half-written slot. With only one consumer the read side needs no CAS: it
+// owns its position outright and just waits for the next slot's sequence to
+// say the item is there. Capacity is rounded up to a power of two.
+template<typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(size_t size)
+        : slots_(round_up_pow2(size)), mask_(slots_.size() - 1) {
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    [[nodiscard]] size_t capacity() const { return slots_.size(); }
+
+    // Any thread; returns false if queue is full
+    bool push(const T& item) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    slot.item = item;
+                    slot.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only; returns nullopt if the next item isn't published
+    // yet (empty, or its producer is still writing it)
+    [[nodiscard]] std::optional<T> pop() {
+        Slot& slot = slots_[dequeue_pos_ & mask_];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1) {
+            return std::nullopt;
+        }
+
+        T item = slot.item;
+        slot.sequence.store(dequeue_pos_ + slots_.size(), std::memory_order_release);
+        ++dequeue_pos_;
+        return item;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T item;
+    };
+
+    static size_t round_up_pow2(size_t n) {
+        size_t size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    std::vector<Slot> slots_;
+    size_t mask_;
+
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) size_t dequeue_pos_ = 0;  // Consumer-owned
+};
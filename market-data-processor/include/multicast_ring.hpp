@@ -0,0 +1,153 @@
+#pragma once
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <span>
+#include <algorithm>
+#include <stdexcept>
+#include <initializer_list>
+
+// Single-producer ring read by several consumers, each at its own pace
+// (Disruptor-style multicast). Every consumer sees every item, read in place
+// from the one shared slot, so nothing is copied per consumer.
+//
+// Positions are free-running sequence numbers: the producer publishes a
+// count, each consumer keeps a cursor of how many items it has finished
+// with. The producer may only overwrite a slot once every consumer is past
+// it, so it gates on the slowest cursor. A consumer registered with
+// add_consumer({a}) also waits for consumer a, so it only ever sees items a
+// has released (e.g. a recorder that must run after the signal engine).
+//
+// Consumers are registered before the producer starts. Each consumer id is
+// driven by one thread. Like LockFreeQueue, both sides cache the index they
+// wait on and only reload it when the cache runs out.
+template<typename T>
+class MulticastRing {
+public:
+    explicit MulticastRing(size_t size, size_t max_consumers = 8)
+        : buffer_(round_up_pow2(size)), mask_(buffer_.size() - 1),
+          consumers_(std::make_unique<Consumer[]>(max_consumers)), max_consumers_(max_consumers) {}
+
+    MulticastRing(const MulticastRing&) = delete;
+    MulticastRing& operator=(const MulticastRing&) = delete;
+
+    [[nodiscard]] size_t capacity() const { return buffer_.size(); }
+    [[nodiscard]] size_t consumer_count() const { return consumer_count_; }
+
+    // Registers a consumer that reads each item only after every consumer in
+    // after has released it; returns its id. Not thread-safe: call before
+    // producing. Throws std::out_of_range past max_consumers or on an unknown
+    // dependency.
+    size_t add_consumer(std::initializer_list<size_t> after = {}) {
+        if (consumer_count_ == max_consumers_) {
+            throw std::out_of_range("MulticastRing: too many consumers");
+        }
+        Consumer& consumer = consumers_[consumer_count_];
+        for (size_t upstream : after) {
+            if (upstream >= consumer_count_) {
+                throw std::out_of_range("MulticastRing: unknown dependency");
+            }
+            consumer.after.push_back(upstream);
+        }
+        return consumer_count_++;
+    }
+
+    // Producer: up to max free slots to construct items in place, contiguous
+    // (stops at the wrap point). Empty if the slowest consumer is a full lap
+    // behind.
+    [[nodiscard]] std::span<T> try_claim(size_t max = 1) {
+        size_t current_head = head_.load(std::memory_order_relaxed);
+        size_t free = buffer_.size() - (current_head - cached_slowest_);
+        if (free < max) {
+            cached_slowest_ = slowest_cursor(current_head);
+            free = buffer_.size() - (current_head - cached_slowest_);
+        }
+        size_t start = current_head & mask_;
+        size_t n = std::min({max, free, buffer_.size() - start});
+        return {buffer_.data() + start, n};
+    }
+
+    // Producer: publishes the first count slots of the last claim to every
+    // consumer
+    void commit(size_t count = 1) {
+        head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    // Producer; returns false if the slowest consumer is a full lap behind
+    bool push(const T& item) {
+        std::span<T> slot = try_claim(1);
+        if (slot.empty()) return false;
+        slot[0] = item;
+        commit(1);
+        return true;
+    }
+
+    // Consumer id: up to max items it hasn't seen, read in place, contiguous
+    // (stops at the wrap point). Empty if it has caught up with the producer
+    // or with its dependencies.
+    [[nodiscard]] std::span<const T> peek(size_t id, size_t max = 1) {
+        Consumer& consumer = consumers_[id];
+        size_t current = consumer.cursor.load(std::memory_order_relaxed);
+        size_t ready = consumer.cached_limit - current;
+        if (ready < max) {
+            consumer.cached_limit = limit(consumer);
+            ready = consumer.cached_limit - current;
+        }
+        size_t start = current & mask_;
+        size_t n = std::min({max, ready, buffer_.size() - start});
+        return {buffer_.data() + start, n};
+    }
+
+    // Consumer id: done with the first count peeked items, which frees them
+    // for downstream consumers and, once everyone is past, the producer
+    void release(size_t id, size_t count = 1) {
+        std::atomic<size_t>& cursor = consumers_[id].cursor;
+        cursor.store(cursor.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    // Cache-line sized so cursors of different consumers don't false-share
+    struct alignas(64) Consumer {
+        std::atomic<size_t> cursor{0};   // Items released
+        size_t cached_limit = 0;         // Consumer-local view of limit()
+        std::vector<size_t> after;       // Consumers it runs behind
+    };
+
+    static size_t round_up_pow2(size_t n) {
+        size_t size = 1;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    // How far consumer may read: what's published, or what its slowest
+    // dependency has released
+    size_t limit(const Consumer& consumer) const {
+        if (consumer.after.empty()) {
+            return head_.load(std::memory_order_acquire);
+        }
+        size_t lowest = consumers_[consumer.after.front()].cursor.load(std::memory_order_acquire);
+        for (size_t upstream : consumer.after) {
+            lowest = std::min(lowest, consumers_[upstream].cursor.load(std::memory_order_acquire));
+        }
+        return lowest;
+    }
+
+    // Producer side: the cursor furthest behind, or head if no consumers
+    size_t slowest_cursor(size_t current_head) const {
+        size_t lowest = current_head;
+        for (size_t i = 0; i < consumer_count_; ++i) {
+            lowest = std::min(lowest, consumers_[i].cursor.load(std::memory_order_acquire));
+        }
+        return lowest;
+    }
+
+    std::vector<T> buffer_;
+    size_t mask_;
+
+    std::unique_ptr<Consumer[]> consumers_;
+    size_t max_consumers_;
+    size_t consumer_count_ = 0;
+
+    alignas(64) std::atomic<size_t> head_{0};   // Items published
+    size_t cached_slowest_ = 0;                 // Producer-local
+};
@@ -1,22 +1,39 @@
 #pragma once
 #include "types.hpp"
+#include "clock.hpp"
+#include "latency_histogram.hpp"
 #include <vector>
 #include <string>
+#include <utility>
 
 class SignalEngine {
 private:
     double total_traded_value_ = 0.0;
     double total_quantity_ = 0.0;
-    std::vector<long> latencies_;   // Per-tick latency in nanoseconds
+    Clock clock_;                   // Must match the producer's
+    LatencyHistogram latencies_;    // Per-tick latency in nanoseconds
+
+    // Optional raw samples for CSV export: (tick_index, latency_ns) for every
+    // sample_every_-th tick, until max_samples_ are kept
+    std::vector<std::pair<uint64_t, long>> samples_;
+    size_t max_samples_;
+    size_t sample_every_;
+    uint64_t ticks_ = 0;
 
 public:
-    SignalEngine();  // Pre-allocates latency storage
+    // Measures receive time on clock, which must be the one the ticks were
+    // stamped with. Keeps no raw samples by default; max_samples > 0
+    // pre-allocates that many for export_latencies_csv()
+    explicit SignalEngine(ClockSource clock = ClockSource::SYSTEM, size_t max_samples = 0, size_t sample_every = 1);
 
     void process_tick(const Tick& tick);
 
+    // Latency distribution so far; safe to read from another thread
+    [[nodiscard]] const LatencyHistogram& latencies() const { return latencies_; }
+
     // Output latency percentiles to console
     void write_latency_report();
 
-    // Export tick_index,latency_ns pairs to CSV
+    // Export sampled tick_index,latency_ns pairs to CSV
     void export_latencies_csv(const std::string& filename);
 };
@@ -1,11 +1,11 @@
 #include "market_sim.hpp"
-#include <chrono>
 
-MarketSimulator::MarketSimulator()
+MarketSimulator::MarketSimulator(ClockSource clock)
     : price_dist_(-0.001, 0.001),   // +-0.1% price change per tick
       qty_dist_(1, 100),
       side_dist_(0, 1),
-      gen_(std::random_device{}())
+      gen_(std::random_device{}()),
+      clock_(clock)
 {
 }
 
@@ -17,11 +17,8 @@ Tick MarketSimulator::next_tick() {
     Side side = static_cast<Side>(side_dist_(gen_));
     double quantity = qty_dist_(gen_);
 
-    // Timestamp in nanoseconds since epoch
-    auto now = std::chrono::system_clock::now();
-    uint64_t timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        now.time_since_epoch()
-    ).count();
+    // Timestamp in nanoseconds on the simulator's clock
+    uint64_t timestamp_ns = clock_.now();
 
     Tick tick = {};
     tick.price = current_price_;
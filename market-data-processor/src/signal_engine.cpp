@@ -1,24 +1,22 @@
 #include "signal_engine.hpp"
 #include <iostream>
 #include <fstream>
-#include <chrono>
-#include <algorithm> // for std::sort
-#include <numeric>   // for std::accumulate
 
-SignalEngine::SignalEngine() {
+SignalEngine::SignalEngine(ClockSource clock, size_t max_samples, size_t sample_every)
+    : clock_(clock), max_samples_(max_samples), sample_every_(sample_every == 0 ? 1 : sample_every) {
     // Avoid reallocation during hot path
-    latencies_.reserve(1'000'000);
+    samples_.reserve(max_samples_);
 }
 
 void SignalEngine::process_tick(const Tick& tick) {
-    // Measure receive time (matches producer's system_clock)
-    auto now = std::chrono::system_clock::now();
-    auto now_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
-        now.time_since_epoch()
-    ).count();
+    // Measure receive time (same clock as the producer's timestamps)
+    long latency = static_cast<long>(clock_.now() - tick.timestamp);
+    latencies_.record(latency);
 
-    long latency = now_nanos - tick.timestamp;
-    latencies_.push_back(latency);
+    if (samples_.size() < max_samples_ && ticks_ % sample_every_ == 0) {
+        samples_.emplace_back(ticks_, latency);
+    }
+    ++ticks_;
 
     // Accumulate for VWAP calculation
     total_traded_value_ += (tick.price * tick.quantity);
@@ -31,34 +29,21 @@ void SignalEngine::write_latency_report() {
         return;
     }
 
-    // Copy for sorting (preserve original order for CSV export)
-    std::vector<long> sorted_latencies = latencies_;
-    std::sort(sorted_latencies.begin(), sorted_latencies.end());
-
-    size_t n = sorted_latencies.size();
-    long min_lat = sorted_latencies.front();
-    long max_lat = sorted_latencies.back();
-    long p50 = sorted_latencies[n * 0.50];
-    long p90 = sorted_latencies[n * 0.90];
-    long p99 = sorted_latencies[n * 0.99];
-
-    double sum = std::accumulate(sorted_latencies.begin(), sorted_latencies.end(), 0.0);
-    double avg = sum / n;
-
     std::cout << "\n--- Latency Report (Nanoseconds) ---" << std::endl;
-    std::cout << "Count: " << n << std::endl;
-    std::cout << "Min:   " << min_lat << " ns" << std::endl;
-    std::cout << "Avg:   " << static_cast<long>(avg) << " ns" << std::endl;
-    std::cout << "P50:   " << p50 << " ns" << std::endl;
-    std::cout << "P90:   " << p90 << " ns" << std::endl;
-    std::cout << "P99:   " << p99 << " ns" << std::endl;
-    std::cout << "Max:   " << max_lat << " ns" << std::endl;
+    std::cout << "Count: " << latencies_.count() << std::endl;
+    std::cout << "Min:   " << latencies_.min() << " ns" << std::endl;
+    std::cout << "Avg:   " << static_cast<long>(latencies_.mean()) << " ns" << std::endl;
+    std::cout << "P50:   " << latencies_.percentile(50.0) << " ns" << std::endl;
+    std::cout << "P90:   " << latencies_.percentile(90.0) << " ns" << std::endl;
+    std::cout << "P99:   " << latencies_.percentile(99.0) << " ns" << std::endl;
+    std::cout << "P99.9: " << latencies_.percentile(99.9) << " ns" << std::endl;
+    std::cout << "Max:   " << latencies_.max() << " ns" << std::endl;
     std::cout << "------------------------------------" << std::endl;
 }
 
 void SignalEngine::export_latencies_csv(const std::string& filename) {
-    if (latencies_.empty()) {
-        std::cerr << "No latencies to export." << std::endl;
+    if (samples_.empty()) {
+        std::cerr << "No latency samples to export (construct SignalEngine with max_samples)." << std::endl;
         return;
     }
 
@@ -71,10 +56,10 @@ void SignalEngine::export_latencies_csv(const std::string& filename) {
     file << "tick_index,latency_ns\n";
 
     // Write in arrival order (unsorted)
-    for (size_t i = 0; i < latencies_.size(); ++i) {
-        file << i << "," << latencies_[i] << "\n";
+    for (const auto& [index, latency] : samples_) {
+        file << index << "," << latency << "\n";
     }
 
     file.close();
-    std::cout << "Exported " << latencies_.size() << " latency samples to: " << filename << std::endl;
+    std::cout << "Exported " << samples_.size() << " latency samples to: " << filename << std::endl;
 }
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "clock.hpp"
+#include <chrono>
+#include <thread>
+
+TEST(ClockTest, ParsesEverySourceByItsName) {
+    for (ClockSource source : {ClockSource::SYSTEM, ClockSource::STEADY, ClockSource::TSC}) {
+        EXPECT_EQ(parse_clock_source(to_string(source)), source);
+    }
+    EXPECT_EQ(parse_clock_source("TSC"), std::nullopt);
+    EXPECT_EQ(parse_clock_source(""), std::nullopt);
+}
+
+TEST(ClockTest, TscFallsBackToSteadyWithoutAnInvariantCounter) {
+    EXPECT_EQ(usable_clock_source(ClockSource::TSC, false), ClockSource::STEADY);
+    EXPECT_EQ(usable_clock_source(ClockSource::TSC, true), ClockSource::TSC);
+    EXPECT_EQ(usable_clock_source(ClockSource::SYSTEM, false), ClockSource::SYSTEM);
+    EXPECT_EQ(usable_clock_source(ClockSource::STEADY, false), ClockSource::STEADY);
+
+    // This machine takes whichever branch its CPU calls for
+    EXPECT_EQ(Clock(ClockSource::TSC).source(),
+              TscClock::available() ? ClockSource::TSC : ClockSource::STEADY);
+}
+
+TEST(ClockTest, SteadyAndTscReadingsNeverGoBackwards) {
+    for (ClockSource source : {ClockSource::STEADY, ClockSource::TSC}) {
+        Clock clock(source);
+        uint64_t previous = clock.now();
+        for (int i = 0; i < 100'000; ++i) {
+            uint64_t now = clock.now();
+            ASSERT_GE(now, previous) << to_string(clock.source());
+            previous = now;
+        }
+    }
+}
+
+TEST(ClockTest, TscTracksSteadyClockNanoseconds) {
+    if (!TscClock::available()) GTEST_SKIP() << "no invariant TSC";
+
+    Clock tsc(ClockSource::TSC);
+    Clock steady(ClockSource::STEADY);
+    uint64_t tsc_start = tsc.now();
+    uint64_t steady_start = steady.now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto tsc_elapsed = static_cast<double>(tsc.now() - tsc_start);
+    auto steady_elapsed = static_cast<double>(steady.now() - steady_start);
+
+    // Loose: only a badly calibrated rate, not scheduling noise, misses this
+    EXPECT_NEAR(tsc_elapsed / steady_elapsed, 1.0, 0.1);
+    EXPECT_GT(TscClock::ticks_per_ns(), 0.0);
+}
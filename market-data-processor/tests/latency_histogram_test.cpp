@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include "latency_histogram.hpp"
+#include <cstdint>
+#include <memory>
+
+TEST(LatencyHistogramTest, EmptyReportsZero) {
+    LatencyHistogram histogram;
+    EXPECT_TRUE(histogram.empty());
+    EXPECT_EQ(histogram.min(), 0);
+    EXPECT_EQ(histogram.max(), 0);
+    EXPECT_EQ(histogram.percentile(50), 0);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 0.0);
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+    LatencyHistogram histogram;
+    for (int v = 1; v <= 100; ++v) histogram.record(v);
+
+    EXPECT_EQ(histogram.count(), 100u);
+    EXPECT_EQ(histogram.min(), 1);
+    EXPECT_EQ(histogram.max(), 100);
+    EXPECT_DOUBLE_EQ(histogram.mean(), 50.5);
+    EXPECT_EQ(histogram.percentile(0), 1);
+    EXPECT_EQ(histogram.percentile(50), 50);
+    EXPECT_EQ(histogram.percentile(99), 99);
+    EXPECT_EQ(histogram.percentile(99.5), 100);
+    EXPECT_EQ(histogram.percentile(100), 100);
+}
+
+TEST(LatencyHistogramTest, BucketsWidenPastTwoHundredFiftySix) {
+    // 255 is the last value with a bucket to itself
+    LatencyHistogram exact;
+    exact.record(255);
+    exact.record(1000);
+    EXPECT_EQ(exact.percentile(50), 255);
+
+    // 256 and 257 share a bucket, reported by its upper bound; 258 starts the next
+    LatencyHistogram shared;
+    shared.record(256);
+    shared.record(258);
+    EXPECT_EQ(shared.percentile(50), 257);
+    EXPECT_EQ(shared.percentile(100), 258);
+
+    // The reported bound is capped at the largest value recorded
+    LatencyHistogram capped;
+    capped.record(256);
+    EXPECT_EQ(capped.percentile(100), 256);
+}
+
+TEST(LatencyHistogramTest, ReportedBoundIsWithinOneBucketOfTheValue) {
+    for (uint64_t v : {uint64_t{300}, uint64_t{4'095}, uint64_t{4'096}, uint64_t{123'456},
+                       uint64_t{1} << 40, (uint64_t{1} << 62) + 12'345}) {
+        auto histogram = std::make_unique<LatencyHistogram>();
+        histogram->record(static_cast<int64_t>(v));
+        histogram->record(INT64_MAX);
+
+        auto bound = static_cast<uint64_t>(histogram->percentile(50));
+        EXPECT_GE(bound, v);
+        EXPECT_LE(bound - v, v / LatencyHistogram::SUB_BUCKETS) << v;
+    }
+}
+
+TEST(LatencyHistogramTest, NegativeValuesCountAsZero) {
+    LatencyHistogram histogram;
+    histogram.record(-5);
+    histogram.record(10);
+    EXPECT_EQ(histogram.min(), 0);
+    EXPECT_EQ(histogram.percentile(50), 0);
+}
+
+TEST(LatencyHistogramTest, MergeCombinesCountsAndExtremes) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    for (int v = 1; v <= 50; ++v) a.record(v);
+    for (int v = 51; v <= 100; ++v) b.record(v);
+
+    a.merge(b);
+    EXPECT_EQ(a.count(), 100u);
+    EXPECT_EQ(a.min(), 1);
+    EXPECT_EQ(a.max(), 100);
+    EXPECT_DOUBLE_EQ(a.mean(), 50.5);
+    EXPECT_EQ(a.percentile(75), 75);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "multicast_ring.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(MulticastRingTest, ProducerWaitsForTheSlowestConsumer) {
+    MulticastRing<int> ring(4);
+    size_t fast = ring.add_consumer();
+    size_t slow = ring.add_consumer();
+
+    for (int i = 0; i < 4; ++i) ASSERT_TRUE(ring.push(i));
+    EXPECT_FALSE(ring.push(4));
+
+    // One consumer catching up frees nothing while the other hasn't
+    auto seen = ring.peek(fast, 8);
+    ASSERT_EQ(seen.size(), 4u);
+    EXPECT_EQ(seen[3], 3);
+    ring.release(fast, 4);
+    EXPECT_FALSE(ring.push(4));
+
+    ASSERT_EQ(ring.peek(slow).front(), 0);
+    ring.release(slow);
+    EXPECT_TRUE(ring.push(4));
+    auto next = ring.peek(fast, 8);
+    ASSERT_EQ(next.size(), 1u);
+    EXPECT_EQ(next[0], 4);
+}
+
+TEST(MulticastRingTest, ChainedConsumerOnlySeesReleasedItems) {
+    MulticastRing<int> ring(8);
+    size_t engine = ring.add_consumer();
+    size_t recorder = ring.add_consumer({engine});
+
+    for (int i = 0; i < 3; ++i) ASSERT_TRUE(ring.push(i));
+    EXPECT_TRUE(ring.peek(recorder, 8).empty());
+
+    ring.release(engine, 2);
+    auto seen = ring.peek(recorder, 8);
+    ASSERT_EQ(seen.size(), 2u);
+    EXPECT_EQ(seen[1], 1);
+}
+
+TEST(MulticastRingTest, RejectsTooManyConsumersAndUnknownDependencies) {
+    MulticastRing<int> ring(8, 2);
+    EXPECT_THROW(ring.add_consumer({0}), std::out_of_range);
+    ring.add_consumer();
+    ring.add_consumer({0});
+    EXPECT_EQ(ring.consumer_count(), 2u);
+    EXPECT_THROW(ring.add_consumer(), std::out_of_range);
+}
+
+TEST(MulticastRingTest, EveryConsumerSeesEveryMessageInOrder) {
+    constexpr uint64_t MESSAGES = 500'000;
+    constexpr int INDEPENDENT = 3;
+    MulticastRing<uint64_t> ring(64);
+    std::vector<size_t> ids;
+    for (int c = 0; c < INDEPENDENT; ++c) ids.push_back(ring.add_consumer());
+    ids.push_back(ring.add_consumer({ids[0], ids[1]}));
+
+    // Per consumer: messages seen, and whether they came in order
+    std::vector<uint64_t> received(ids.size(), 0);
+    std::vector<char> ordered(ids.size(), 1);
+    std::vector<std::thread> consumers;
+    for (size_t c = 0; c < ids.size(); ++c) {
+        consumers.emplace_back([&, c] {
+            while (received[c] < MESSAGES) {
+                auto items = ring.peek(ids[c], 16);
+                for (uint64_t item : items) ordered[c] &= item == received[c]++;
+                ring.release(ids[c], items.size());
+                if (items.empty()) std::this_thread::yield();
+            }
+        });
+    }
+
+    // In-place batches of varying size, wrapping the ring many times
+    for (uint64_t next = 0; next < MESSAGES;) {
+        auto slots = ring.try_claim(1 + next % 7);
+        for (auto& slot : slots) slot = next++;
+        ring.commit(slots.size());
+        if (slots.empty()) std::this_thread::yield();
+    }
+    for (auto& consumer : consumers) consumer.join();
+
+    for (size_t c = 0; c < ids.size(); ++c) {
+        EXPECT_EQ(received[c], MESSAGES) << "consumer " << c;
+        EXPECT_TRUE(ordered[c]) << "consumer " << c;
+    }
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include "lock_free_queue.hpp"
+#include "mpmc_queue.hpp"
+#include "mpsc_queue.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr int PRODUCERS = 4;
+constexpr uint64_t PER_PRODUCER = 100'000;
+
+// Producer p's i-th item
+uint64_t tag(int p, uint64_t i) { return static_cast<uint64_t>(p) << 32 | i; }
+
+// Pushes PER_PRODUCER tagged items from each of PRODUCERS threads
+template <typename Queue>
+std::vector<std::thread> start_producers(Queue& queue) {
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (uint64_t i = 0; i < PER_PRODUCER; ++i) {
+                while (!queue.push(tag(p, i))) std::this_thread::yield();
+            }
+        });
+    }
+    return producers;
+}
+
+// Every tagged item exactly once
+void expect_each_once(std::vector<uint64_t> received) {
+    ASSERT_EQ(received.size(), PRODUCERS * PER_PRODUCER);
+    std::sort(received.begin(), received.end());
+    for (int p = 0; p < PRODUCERS; ++p) {
+        for (uint64_t i = 0; i < PER_PRODUCER; ++i) {
+            ASSERT_EQ(received[p * PER_PRODUCER + i], tag(p, i));
+        }
+    }
+}
+
+// Single-threaded FIFO, full/empty edges and many laps around the ring
+template <typename Queue>
+void expect_bounded_fifo() {
+    Queue queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    EXPECT_FALSE(queue.pop());
+
+    for (uint64_t i = 0; i < 4; ++i) EXPECT_TRUE(queue.push(i));
+    EXPECT_FALSE(queue.push(4));
+    for (uint64_t i = 0; i < 4; ++i) EXPECT_EQ(queue.pop(), i);
+    EXPECT_FALSE(queue.pop());
+
+    // Three in, two out: the positions wrap the slots many times over
+    uint64_t next_in = 0;
+    uint64_t next_out = 0;
+    for (int round = 0; round < 100; ++round) {
+        while (queue.push(next_in)) ++next_in;
+        for (int k = 0; k < 2; ++k) EXPECT_EQ(queue.pop(), next_out++);
+    }
+    while (auto item = queue.pop()) EXPECT_EQ(*item, next_out++);
+    EXPECT_EQ(next_out, next_in);
+}
+
+}
+
+TEST(MpscQueueTest, BoundedFifoAcrossWraparound) {
+    expect_bounded_fifo<MpscQueue<uint64_t>>();
+}
+
+TEST(MpscQueueTest, ManyProducersDeliverEachItemOnceInProducerOrder) {
+    MpscQueue<uint64_t> queue(1024);
+    auto producers = start_producers(queue);
+
+    std::vector<uint64_t> received;
+    received.reserve(PRODUCERS * PER_PRODUCER);
+    std::vector<uint64_t> next(PRODUCERS, 0);
+    bool ordered = true;
+    while (received.size() < PRODUCERS * PER_PRODUCER) {
+        auto item = queue.pop();
+        if (!item) {
+            std::this_thread::yield();
+            continue;
+        }
+        auto p = static_cast<size_t>(*item >> 32);
+        ordered &= (*item & 0xFFFF'FFFF) == next[p]++;
+        received.push_back(*item);
+    }
+    for (auto& producer : producers) producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_FALSE(queue.pop());
+    expect_each_once(std::move(received));
+}
+
+TEST(MpmcQueueTest, BoundedFifoAcrossWraparound) {
+    expect_bounded_fifo<MpmcQueue<uint64_t>>();
+}
+
+TEST(MpmcQueueTest, ManyProducersAndConsumersDeliverEachItemOnce) {
+    constexpr int CONSUMERS = 4;
+    MpmcQueue<uint64_t> queue(1024);
+    std::atomic<uint64_t> consumed{0};
+
+    std::vector<std::vector<uint64_t>> received(CONSUMERS);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < CONSUMERS; ++c) {
+        consumers.emplace_back([&, c] {
+            while (consumed.load(std::memory_order_relaxed) < PRODUCERS * PER_PRODUCER) {
+                if (auto item = queue.pop()) {
+                    received[c].push_back(*item);
+                    consumed.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    auto producers = start_producers(queue);
+    for (auto& producer : producers) producer.join();
+    for (auto& consumer : consumers) consumer.join();
+
+    std::vector<uint64_t> all;
+    for (const auto& mine : received) all.insert(all.end(), mine.begin(), mine.end());
+    EXPECT_FALSE(queue.pop());
+    expect_each_once(std::move(all));
+}
+
+TEST(LockFreeQueueTest, BatchesKeepOrderAndStopAtFullAndEmpty) {
+    LockFreeQueue<int> queue(8);
+    std::vector<int> in(12);
+    std::iota(in.begin(), in.end(), 0);
+    std::vector<int> out(16, -1);
+
+    EXPECT_EQ(queue.pop_n(out), 0u);
+    EXPECT_EQ(queue.push_n(std::span<const int>(in).first(5)), 5u);
+    EXPECT_EQ(queue.pop_n(std::span<int>(out).first(3)), 3u);
+    EXPECT_EQ(out[0], 0);
+    EXPECT_EQ(out[2], 2);
+
+    // Six free slots, the last four past the end of the array
+    EXPECT_EQ(queue.push_n(std::span<const int>(in).subspan(5)), 6u);
+    EXPECT_EQ(queue.push_n(std::span<const int>(in).subspan(11)), 0u);
+    EXPECT_FALSE(queue.push(99));
+
+    EXPECT_EQ(queue.pop_n(out), 8u);
+    for (int i = 0; i < 8; ++i) EXPECT_EQ(out[i], i + 3);
+    EXPECT_FALSE(queue.pop());
+}
+
+TEST(LockFreeQueueTest, ClaimAndPeekStopAtTheWrapPoint) {
+    LockFreeQueue<int> queue(8);
+    for (int i = 0; i < 6; ++i) ASSERT_TRUE(queue.push(i));
+    for (int i = 0; i < 6; ++i) ASSERT_EQ(queue.pop(), i);
+
+    // Head at slot 6: a claim reaches the end of the array, then starts over
+    auto first = queue.try_claim(8);
+    ASSERT_EQ(first.size(), 2u);
+    first[0] = 100;
+    first[1] = 101;
+    EXPECT_TRUE(queue.peek(8).empty());  // Not visible before commit
+    queue.commit(2);
+
+    auto second = queue.try_claim(8);
+    ASSERT_EQ(second.size(), 6u);
+    for (int i = 0; i < 6; ++i) second[i] = 102 + i;
+    queue.commit(6);
+    EXPECT_TRUE(queue.try_claim(8).empty());
+
+    auto front = queue.peek(8);
+    ASSERT_EQ(front.size(), 2u);
+    EXPECT_EQ(front[0], 100);
+    queue.release(1);
+    EXPECT_EQ(queue.peek(8).front(), 101);
+    queue.release(1);
+
+    auto rest = queue.peek(8);
+    ASSERT_EQ(rest.size(), 6u);
+    EXPECT_EQ(rest.back(), 107);
+    EXPECT_EQ(queue.try_claim(8).size(), 2u);  // Released slots are free again
+    queue.release(6);
+    EXPECT_TRUE(queue.peek(8).empty());
+}
+
+TEST(LockFreeQueueTest, BatchesAcrossThreadsDeliverEverythingInOrder) {
+    constexpr int ITEMS = 1'000'000;
+    LockFreeQueue<int> queue(256);
+
+    std::thread producer([&] {
+        std::vector<int> batch(37);
+        for (int next = 0; next < ITEMS;) {
+            size_t n = std::min<size_t>(batch.size(), static_cast<size_t>(ITEMS - next));
+            for (size_t i = 0; i < n; ++i) batch[i] = next + static_cast<int>(i);
+            size_t pushed = 0;
+            while (pushed < n) {
+                pushed += queue.push_n(std::span<const int>(batch).subspan(pushed, n - pushed));
+            }
+            next += static_cast<int>(n);
+        }
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    while (expected < ITEMS) {
+        auto items = queue.peek(64);
+        for (int item : items) ordered &= item == expected++;
+        queue.release(items.size());
+    }
+    producer.join();
+
+    EXPECT_TRUE(ordered);
+    EXPECT_FALSE(queue.pop());
+}